@@ -0,0 +1,193 @@
+package cl30_test
+
+import (
+	"testing"
+	"unsafe"
+
+	cl "github.com/opencl-go/cl30"
+)
+
+// The host-only benchmarks below measure the binding-layer overhead that is independent of any
+// OpenCL implementation; they run everywhere. The device benchmarks further down measure the
+// full per-call cost of the hot wrappers and skip when no OpenCL device is available.
+
+func BenchmarkNDRangeSetWorkDimensions(b *testing.B) {
+	var ndRange cl.NDRange
+	dimensions := []cl.WorkDimension{
+		{GlobalSize: 1024, LocalSize: 64},
+		{GlobalSize: 512, LocalSize: 8},
+	}
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if err := ndRange.SetWorkDimensions(dimensions); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func BenchmarkCommandBatchRecord(b *testing.B) {
+	var batch cl.CommandBatch
+	data := make([]byte, 16)
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		batch.RecordWriteBuffer(0, false, 0, uintptr(len(data)), unsafe.Pointer(&data[0]))
+		batch.RecordCopyBuffer(0, 0, 0, 0, uintptr(len(data)))
+		batch.RecordMarker()
+		batch.Reset()
+	}
+}
+
+func BenchmarkKernelArgBatchRecord(b *testing.B) {
+	var batch cl.KernelArgBatch
+	value := uint32(0)
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		for index := uint32(0); index < 12; index++ {
+			batch.Record(index, unsafe.Sizeof(value), unsafe.Pointer(&value))
+		}
+		batch.Reset()
+	}
+}
+
+// benchmarkContext returns a context and in-order queue on the first available device, skipping
+// the benchmark when the environment provides no OpenCL implementation or device.
+func benchmarkContext(b *testing.B) (cl.Context, cl.CommandQueue, cl.DeviceID) {
+	b.Helper()
+	platforms, err := cl.PlatformIDs()
+	if (err != nil) || (len(platforms) == 0) {
+		b.Skip("no OpenCL platform available")
+	}
+	devices, err := cl.DeviceIDs(platforms[0], cl.DeviceTypeAll)
+	if (err != nil) || (len(devices) == 0) {
+		b.Skip("no OpenCL device available")
+	}
+	context, err := cl.CreateContext(devices[:1], nil)
+	if err != nil {
+		b.Skip("context creation failed: ", err)
+	}
+	queue, err := cl.CreateCommandQueueWithProperties(context, devices[0])
+	if err != nil {
+		_ = cl.ReleaseContext(context)
+		b.Skip("queue creation failed: ", err)
+	}
+	b.Cleanup(func() {
+		_ = cl.ReleaseCommandQueue(queue)
+		_ = cl.ReleaseContext(context)
+	})
+	return context, queue, devices[0]
+}
+
+// benchmarkKernel builds a minimal kernel with one buffer argument.
+func benchmarkKernel(b *testing.B, context cl.Context, device cl.DeviceID) cl.Kernel {
+	b.Helper()
+	program, err := cl.CreateProgramWithSource(context,
+		[]string{"__kernel void bench(__global uint *data) { data[get_global_id(0)]++; }"})
+	if err != nil {
+		b.Skip("program creation failed: ", err)
+	}
+	err = cl.BuildProgram(program, []cl.DeviceID{device}, "", nil)
+	if err != nil {
+		_ = cl.ReleaseProgram(program)
+		b.Skip("program build failed: ", err)
+	}
+	kernel, err := cl.CreateKernel(program, "bench")
+	if err != nil {
+		_ = cl.ReleaseProgram(program)
+		b.Skip("kernel creation failed: ", err)
+	}
+	b.Cleanup(func() {
+		_ = cl.ReleaseKernel(kernel)
+		_ = cl.ReleaseProgram(program)
+	})
+	return kernel
+}
+
+func BenchmarkSetKernelArg(b *testing.B) {
+	context, _, device := benchmarkContext(b)
+	kernel := benchmarkKernel(b, context, device)
+	mem, err := cl.CreateBuffer(context, cl.MemReadWriteFlag, 1024, nil)
+	if err != nil {
+		b.Fatal(err)
+	}
+	b.Cleanup(func() { _ = cl.ReleaseMemObject(mem) })
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if err := cl.SetKernelArg(kernel, 0, unsafe.Sizeof(mem), unsafe.Pointer(&mem)); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func BenchmarkEnqueueNDRangeKernel(b *testing.B) {
+	context, queue, device := benchmarkContext(b)
+	kernel := benchmarkKernel(b, context, device)
+	mem, err := cl.CreateBuffer(context, cl.MemReadWriteFlag, 1024, nil)
+	if err != nil {
+		b.Fatal(err)
+	}
+	b.Cleanup(func() { _ = cl.ReleaseMemObject(mem) })
+	if err := cl.SetKernelArg(kernel, 0, unsafe.Sizeof(mem), unsafe.Pointer(&mem)); err != nil {
+		b.Fatal(err)
+	}
+	dimensions := []cl.WorkDimension{{GlobalSize: 256}}
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if err := cl.EnqueueNDRangeKernel(queue, kernel, dimensions, nil, nil); err != nil {
+			b.Fatal(err)
+		}
+	}
+	b.StopTimer()
+	_ = cl.Finish(queue)
+}
+
+func BenchmarkEnqueueReadBuffer(b *testing.B) {
+	context, queue, _ := benchmarkContext(b)
+	mem, err := cl.CreateBuffer(context, cl.MemReadWriteFlag, 1024, nil)
+	if err != nil {
+		b.Fatal(err)
+	}
+	b.Cleanup(func() { _ = cl.ReleaseMemObject(mem) })
+	data := make([]byte, 1024)
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if err := cl.EnqueueReadBuffer(queue, mem, true, 0, uintptr(len(data)), unsafe.Pointer(&data[0]), nil, nil); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func BenchmarkWaitForEvents(b *testing.B) {
+	context, queue, _ := benchmarkContext(b)
+	_ = context
+	events := make([]cl.Event, 1)
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if err := cl.EnqueueMarkerWithWaitList(queue, nil, &events[0]); err != nil {
+			b.Fatal(err)
+		}
+		if err := cl.WaitForEvents(events); err != nil {
+			b.Fatal(err)
+		}
+		if err := cl.ReleaseEvent(events[0]); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func BenchmarkDeviceInfoString(b *testing.B) {
+	_, _, device := benchmarkContext(b)
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if _, err := cl.DeviceInfoString(device, cl.DeviceNameInfo); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
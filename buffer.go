@@ -20,7 +20,7 @@ func CreateBuffer(context Context, flags MemFlags, size int, hostPtr unsafe.Poin
 	if status != C.CL_SUCCESS {
 		return 0, StatusError(status)
 	}
-	return MemObject(*((*uintptr)(unsafe.Pointer(&mem)))), nil
+	return trackedMemObject(mem), nil
 }
 
 // CreateBufferWithProperties creates a buffer object.
@@ -48,7 +48,7 @@ func CreateBufferWithProperties(context Context, flags MemFlags, size int, hostP
 	if status != C.CL_SUCCESS {
 		return 0, StatusError(status)
 	}
-	return MemObject(*((*uintptr)(unsafe.Pointer(&mem)))), nil
+	return trackedMemObject(mem), nil
 }
 
 // BufferCreateType determines the kind of sub-buffer object.
@@ -90,7 +90,7 @@ func CreateSubBuffer(buffer MemObject, flags MemFlags, createType BufferCreateTy
 	if status != C.CL_SUCCESS {
 		return 0, StatusError(status)
 	}
-	return MemObject(*((*uintptr)(unsafe.Pointer(&mem)))), nil
+	return trackedMemObject(mem), nil
 }
 
 // EnqueueMapBuffer enqueues a command to map a region of a buffer object into the host address space and
@@ -119,6 +119,7 @@ func EnqueueMapBuffer(commandQueue CommandQueue,
 	if status != C.CL_SUCCESS {
 		return nil, StatusError(status)
 	}
+	trackEventOut(event)
 	return ptr, nil
 }
 
@@ -144,6 +145,7 @@ func EnqueueReadBuffer(commandQueue CommandQueue, mem MemObject, blockingRead bo
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
@@ -176,6 +178,7 @@ func EnqueueReadBufferRect(commandQueue CommandQueue, mem MemObject, blockingRea
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
@@ -201,6 +204,7 @@ func EnqueueWriteBuffer(commandQueue CommandQueue, mem MemObject, blockingRead b
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
@@ -233,6 +237,7 @@ func EnqueueWriteBufferRect(commandQueue CommandQueue, mem MemObject, blockingRe
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
@@ -259,6 +264,7 @@ func EnqueueFillBuffer(commandQueue CommandQueue, mem MemObject, pattern unsafe.
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
@@ -283,6 +289,7 @@ func EnqueueCopyBuffer(commandQueue CommandQueue, src, dst MemObject, srcOffset,
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
@@ -314,5 +321,6 @@ func EnqueueCopyBufferRect(commandQueue CommandQueue, src, dst MemObject, srcOri
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
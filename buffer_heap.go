@@ -0,0 +1,162 @@
+package cl30
+
+import (
+	"sort"
+	"sync"
+	"unsafe"
+)
+
+// bufferHeapBlock is one contiguous free range within a BufferHeap.
+type bufferHeapBlock struct {
+	origin uintptr
+	size   uintptr
+}
+
+// BufferHeap serves sub-buffers from one large buffer object.
+//
+// Creating many small standalone buffers with CreateBuffer() fragments driver memory, and each
+// creation is a context-locked driver call. A BufferHeap allocates one large MemObject up front
+// and carves aligned regions out of it with CreateSubBuffer(), managed through a best-fit free
+// list on the host.
+//
+// Freeing is tied to the object lifecycle: every handed-out sub-buffer carries a destructor
+// callback, so a region returns to the free list - coalescing with its neighbours - once the
+// sub-buffer is released and no longer used by enqueued commands. Callers therefore release
+// sub-buffers with the regular ReleaseMemObject().
+//
+// A BufferHeap is safe for concurrent use.
+type BufferHeap struct {
+	mem       MemObject
+	alignment uintptr
+
+	mutex sync.Mutex
+	free  []bufferHeapBlock
+}
+
+// NewBufferHeap creates a heap over a newly allocated buffer object of the given size in bytes.
+//
+// The alignment, in bytes, is applied to the origin of every sub-buffer; it must match the base
+// address alignment requirement of the devices using the heap, as per DeviceMemBaseAddrAlignInfo
+// (note that this device query reports bits, not bytes).
+func NewBufferHeap(context Context, flags MemFlags, size int, alignment uintptr) (*BufferHeap, error) {
+	if (size <= 0) || (alignment == 0) || ((alignment & (alignment - 1)) != 0) {
+		return nil, ErrInvalidValue
+	}
+	mem, err := CreateBuffer(context, flags, size, nil)
+	if err != nil {
+		return nil, err
+	}
+	return &BufferHeap{
+		mem:       mem,
+		alignment: alignment,
+		free:      []bufferHeapBlock{{origin: 0, size: uintptr(size)}},
+	}, nil
+}
+
+// Mem returns the underlying buffer object of the heap.
+func (heap *BufferHeap) Mem() MemObject {
+	return heap.mem
+}
+
+// Alloc returns a sub-buffer of the given size in bytes, carved from the best-fitting free block.
+// The flags are passed to CreateSubBuffer(); see there for valid combinations with the flags of
+// the underlying buffer.
+//
+// ErrMemObjectAllocationFailure is returned if no free block can serve the request.
+func (heap *BufferHeap) Alloc(size int, flags MemFlags) (MemObject, error) {
+	if size <= 0 {
+		return 0, ErrInvalidBufferSize
+	}
+	block, ok := heap.takeBlock(uintptr(size))
+	if !ok {
+		return 0, ErrMemObjectAllocationFailure
+	}
+	region := BufferRegion{Origin: block.origin, Size: block.size}
+	subBuffer, err := CreateSubBuffer(heap.mem, flags, BufferCreateTypeRegion, unsafe.Pointer(&region))
+	if err != nil {
+		heap.reclaim(block)
+		return 0, err
+	}
+	err = SetMemObjectDestructorCallback(subBuffer, func() {
+		heap.reclaim(block)
+	})
+	if err != nil {
+		_ = ReleaseMemObject(subBuffer)
+		heap.reclaim(block)
+		return 0, err
+	}
+	return subBuffer, nil
+}
+
+// Release releases the underlying buffer object.
+// Outstanding sub-buffers keep their region alive until they are released themselves.
+func (heap *BufferHeap) Release() error {
+	return ReleaseMemObject(heap.mem)
+}
+
+// takeBlock removes an aligned range of the given size from the best-fitting free block.
+// Leading and trailing remainders of the carved block stay on the free list.
+func (heap *BufferHeap) takeBlock(size uintptr) (bufferHeapBlock, bool) {
+	heap.mutex.Lock()
+	defer heap.mutex.Unlock()
+	bestIndex := -1
+	for i, block := range heap.free {
+		padding := heap.paddingFor(block.origin)
+		if block.size < (padding + size) {
+			continue
+		}
+		if (bestIndex < 0) || (block.size < heap.free[bestIndex].size) {
+			bestIndex = i
+		}
+	}
+	if bestIndex < 0 {
+		return bufferHeapBlock{}, false
+	}
+	block := heap.free[bestIndex]
+	heap.free = append(heap.free[:bestIndex], heap.free[bestIndex+1:]...)
+	padding := heap.paddingFor(block.origin)
+	if padding > 0 {
+		heap.insertLocked(bufferHeapBlock{origin: block.origin, size: padding})
+	}
+	taken := bufferHeapBlock{origin: block.origin + padding, size: size}
+	trailing := block.size - padding - size
+	if trailing > 0 {
+		heap.insertLocked(bufferHeapBlock{origin: taken.origin + size, size: trailing})
+	}
+	return taken, true
+}
+
+// reclaim returns a range to the free list, coalescing it with adjacent blocks.
+func (heap *BufferHeap) reclaim(block bufferHeapBlock) {
+	heap.mutex.Lock()
+	defer heap.mutex.Unlock()
+	heap.insertLocked(block)
+}
+
+// paddingFor returns the number of bytes needed to advance origin to the heap alignment.
+func (heap *BufferHeap) paddingFor(origin uintptr) uintptr {
+	remainder := origin % heap.alignment
+	if remainder == 0 {
+		return 0
+	}
+	return heap.alignment - remainder
+}
+
+// insertLocked inserts a block into the origin-sorted free list and merges adjacent neighbours.
+// The caller must hold the heap mutex.
+func (heap *BufferHeap) insertLocked(block bufferHeapBlock) {
+	index := sort.Search(len(heap.free), func(i int) bool {
+		return heap.free[i].origin > block.origin
+	})
+	heap.free = append(heap.free, bufferHeapBlock{})
+	copy(heap.free[index+1:], heap.free[index:])
+	heap.free[index] = block
+	if (index+1 < len(heap.free)) && ((block.origin + block.size) == heap.free[index+1].origin) {
+		heap.free[index].size += heap.free[index+1].size
+		heap.free = append(heap.free[:index+1], heap.free[index+2:]...)
+	}
+	if (index > 0) && ((heap.free[index-1].origin + heap.free[index-1].size) == block.origin) {
+		heap.free[index-1].size += heap.free[index].size
+		heap.free = append(heap.free[:index], heap.free[index+1:]...)
+	}
+}
@@ -0,0 +1,60 @@
+#include "cl_khr_command_buffer.h"
+
+typedef cl30CommandBufferKhr (CL_API_CALL *cl30CreateCommandBufferKHR_fn)(cl_uint,
+    cl_command_queue const *, cl30CommandBufferPropertiesKhr const *, cl_int *);
+typedef cl_int (CL_API_CALL *cl30FinalizeCommandBufferKHR_fn)(cl30CommandBufferKhr);
+typedef cl_int (CL_API_CALL *cl30RetainCommandBufferKHR_fn)(cl30CommandBufferKhr);
+typedef cl_int (CL_API_CALL *cl30ReleaseCommandBufferKHR_fn)(cl30CommandBufferKhr);
+typedef cl_int (CL_API_CALL *cl30EnqueueCommandBufferKHR_fn)(cl_uint, cl_command_queue *,
+    cl30CommandBufferKhr, cl_uint, cl_event const *, cl_event *);
+typedef cl_int (CL_API_CALL *cl30CommandNDRangeKernelKHR_fn)(cl30CommandBufferKhr, cl_command_queue,
+    void const *, cl_kernel, cl_uint, size_t const *, size_t const *, size_t const *,
+    cl_uint, cl30SyncPointKhr const *, cl30SyncPointKhr *, void *);
+typedef cl_int (CL_API_CALL *cl30CommandBarrierWithWaitListKHR_fn)(cl30CommandBufferKhr, cl_command_queue,
+    void const *, cl_uint, cl30SyncPointKhr const *, cl30SyncPointKhr *, void *);
+
+cl30CommandBufferKhr cl30ExtCreateCommandBufferKHR(void *fn, cl_uint numQueues, cl_command_queue const *queues,
+    cl30CommandBufferPropertiesKhr const *properties, cl_int *errcodeReturn)
+{
+    return ((cl30CreateCommandBufferKHR_fn)(fn))(numQueues, queues, properties, errcodeReturn);
+}
+
+cl_int cl30ExtFinalizeCommandBufferKHR(void *fn, cl30CommandBufferKhr commandBuffer)
+{
+    return ((cl30FinalizeCommandBufferKHR_fn)(fn))(commandBuffer);
+}
+
+cl_int cl30ExtRetainCommandBufferKHR(void *fn, cl30CommandBufferKhr commandBuffer)
+{
+    return ((cl30RetainCommandBufferKHR_fn)(fn))(commandBuffer);
+}
+
+cl_int cl30ExtReleaseCommandBufferKHR(void *fn, cl30CommandBufferKhr commandBuffer)
+{
+    return ((cl30ReleaseCommandBufferKHR_fn)(fn))(commandBuffer);
+}
+
+cl_int cl30ExtEnqueueCommandBufferKHR(void *fn, cl_uint numQueues, cl_command_queue *queues,
+    cl30CommandBufferKhr commandBuffer, cl_uint waitListCount, cl_event const *waitList, cl_event *event)
+{
+    return ((cl30EnqueueCommandBufferKHR_fn)(fn))(numQueues, queues, commandBuffer, waitListCount, waitList, event);
+}
+
+cl_int cl30ExtCommandNDRangeKernelKHR(void *fn, cl30CommandBufferKhr commandBuffer, cl_command_queue commandQueue,
+    void const *properties, cl_kernel kernel, cl_uint workDim,
+    size_t const *globalWorkOffset, size_t const *globalWorkSize, size_t const *localWorkSize,
+    cl_uint syncPointWaitListCount, cl30SyncPointKhr const *syncPointWaitList, cl30SyncPointKhr *syncPoint,
+    void *mutableHandle)
+{
+    return ((cl30CommandNDRangeKernelKHR_fn)(fn))(commandBuffer, commandQueue, properties, kernel, workDim,
+        globalWorkOffset, globalWorkSize, localWorkSize,
+        syncPointWaitListCount, syncPointWaitList, syncPoint, mutableHandle);
+}
+
+cl_int cl30ExtCommandBarrierWithWaitListKHR(void *fn, cl30CommandBufferKhr commandBuffer, cl_command_queue commandQueue,
+    void const *properties, cl_uint syncPointWaitListCount, cl30SyncPointKhr const *syncPointWaitList,
+    cl30SyncPointKhr *syncPoint, void *mutableHandle)
+{
+    return ((cl30CommandBarrierWithWaitListKHR_fn)(fn))(commandBuffer, commandQueue, properties,
+        syncPointWaitListCount, syncPointWaitList, syncPoint, mutableHandle);
+}
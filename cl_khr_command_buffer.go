@@ -0,0 +1,259 @@
+package cl30
+
+// #include "cl_khr_command_buffer.h"
+import "C"
+import (
+	"fmt"
+	"unsafe"
+)
+
+// CommandBufferKhr references a command-buffer object of the "cl_khr_command_buffer" extension.
+// Create a new command-buffer with ExtensionCommandBufferKhr.CreateCommandBuffer().
+//
+// Extension: KhrCommandBufferExtensionName
+type CommandBufferKhr uintptr
+
+func (cb CommandBufferKhr) handle() C.cl30CommandBufferKhr {
+	return *(*C.cl30CommandBufferKhr)(unsafe.Pointer(&cb))
+}
+
+// String provides a readable presentation of the command-buffer identifier.
+// It is based on the numerical value of the underlying pointer.
+func (cb CommandBufferKhr) String() string {
+	return fmt.Sprintf("0x%X", uintptr(cb))
+}
+
+// SyncPointKhr identifies a recorded command within a command-buffer, for expressing dependencies
+// between recorded commands.
+//
+// Extension: KhrCommandBufferExtensionName
+type SyncPointKhr uint32
+
+// KhrCommandBufferExtensionName is the official name of the extension handled by
+// ExtensionCommandBufferKhr.
+const KhrCommandBufferExtensionName = "cl_khr_command_buffer"
+
+// ExtensionCommandBufferKhr represents the functionality provided by the "cl_khr_command_buffer"
+// extension. Load the extension with LoadExtensionCommandBufferKhr().
+//
+// Command-buffers record a sequence of commands once and replay them with a single enqueue.
+// Command sequences that are identical every iteration thereby avoid the per-command enqueue
+// and validation overhead on each repetition.
+//
+// See also: https://registry.khronos.org/OpenCL/sdk/3.0/docs/man/html/cl_khr_command_buffer.html
+// Extension: KhrCommandBufferExtensionName
+type ExtensionCommandBufferKhr struct {
+	clCreateCommandBufferKhr        unsafe.Pointer
+	clFinalizeCommandBufferKhr      unsafe.Pointer
+	clRetainCommandBufferKhr        unsafe.Pointer
+	clReleaseCommandBufferKhr       unsafe.Pointer
+	clEnqueueCommandBufferKhr       unsafe.Pointer
+	clCommandNDRangeKernelKhr       unsafe.Pointer
+	clCommandBarrierWithWaitListKhr unsafe.Pointer
+}
+
+// LoadExtensionCommandBufferKhr loads the required functions for the extension and returns an
+// instance to ExtensionCommandBufferKhr if possible.
+//
+// Extension: KhrCommandBufferExtensionName
+func LoadExtensionCommandBufferKhr(id PlatformID) (*ExtensionCommandBufferKhr, error) {
+	ext := &ExtensionCommandBufferKhr{
+		clCreateCommandBufferKhr:        ExtensionFunctionAddressForPlatform(id, "clCreateCommandBufferKHR"),
+		clFinalizeCommandBufferKhr:      ExtensionFunctionAddressForPlatform(id, "clFinalizeCommandBufferKHR"),
+		clRetainCommandBufferKhr:        ExtensionFunctionAddressForPlatform(id, "clRetainCommandBufferKHR"),
+		clReleaseCommandBufferKhr:       ExtensionFunctionAddressForPlatform(id, "clReleaseCommandBufferKHR"),
+		clEnqueueCommandBufferKhr:       ExtensionFunctionAddressForPlatform(id, "clEnqueueCommandBufferKHR"),
+		clCommandNDRangeKernelKhr:       ExtensionFunctionAddressForPlatform(id, "clCommandNDRangeKernelKHR"),
+		clCommandBarrierWithWaitListKhr: ExtensionFunctionAddressForPlatform(id, "clCommandBarrierWithWaitListKHR"),
+	}
+	if (ext.clCreateCommandBufferKhr == nil) || (ext.clFinalizeCommandBufferKhr == nil) ||
+		(ext.clRetainCommandBufferKhr == nil) || (ext.clReleaseCommandBufferKhr == nil) ||
+		(ext.clEnqueueCommandBufferKhr == nil) || (ext.clCommandNDRangeKernelKhr == nil) ||
+		(ext.clCommandBarrierWithWaitListKhr == nil) {
+		return nil, ErrExtensionNotAvailable
+	}
+	return ext, nil
+}
+
+// CreateCommandBuffer creates a command-buffer that records commands for the given command-queues.
+//
+// See also: https://registry.khronos.org/OpenCL/sdk/3.0/docs/man/html/clCreateCommandBufferKHR.html
+// Extension: KhrCommandBufferExtensionName
+func (ext *ExtensionCommandBufferKhr) CreateCommandBuffer(commandQueues []CommandQueue) (CommandBufferKhr, error) {
+	if (ext == nil) || (ext.clCreateCommandBufferKhr == nil) {
+		return 0, ErrExtensionNotLoaded
+	}
+	var rawQueues unsafe.Pointer
+	if len(commandQueues) > 0 {
+		rawQueues = unsafe.Pointer(&commandQueues[0])
+	}
+	var status C.cl_int
+	commandBuffer := C.cl30ExtCreateCommandBufferKHR(
+		ext.clCreateCommandBufferKhr,
+		C.cl_uint(len(commandQueues)),
+		(*C.cl_command_queue)(rawQueues),
+		nil,
+		&status)
+	if status != C.CL_SUCCESS {
+		return 0, StatusError(status)
+	}
+	return CommandBufferKhr(*((*uintptr)(unsafe.Pointer(&commandBuffer)))), nil
+}
+
+// FinalizeCommandBuffer finalizes the recording; no further commands can be added afterwards,
+// and the command-buffer becomes ready for enqueueing.
+//
+// See also: https://registry.khronos.org/OpenCL/sdk/3.0/docs/man/html/clFinalizeCommandBufferKHR.html
+// Extension: KhrCommandBufferExtensionName
+func (ext *ExtensionCommandBufferKhr) FinalizeCommandBuffer(commandBuffer CommandBufferKhr) error {
+	if (ext == nil) || (ext.clFinalizeCommandBufferKhr == nil) {
+		return ErrExtensionNotLoaded
+	}
+	status := C.cl30ExtFinalizeCommandBufferKHR(ext.clFinalizeCommandBufferKhr, commandBuffer.handle())
+	if status != C.CL_SUCCESS {
+		return StatusError(status)
+	}
+	return nil
+}
+
+// RetainCommandBuffer increments the command-buffer reference count.
+//
+// See also: https://registry.khronos.org/OpenCL/sdk/3.0/docs/man/html/clRetainCommandBufferKHR.html
+// Extension: KhrCommandBufferExtensionName
+func (ext *ExtensionCommandBufferKhr) RetainCommandBuffer(commandBuffer CommandBufferKhr) error {
+	if (ext == nil) || (ext.clRetainCommandBufferKhr == nil) {
+		return ErrExtensionNotLoaded
+	}
+	status := C.cl30ExtRetainCommandBufferKHR(ext.clRetainCommandBufferKhr, commandBuffer.handle())
+	if status != C.CL_SUCCESS {
+		return StatusError(status)
+	}
+	return nil
+}
+
+// ReleaseCommandBuffer decrements the command-buffer reference count.
+//
+// See also: https://registry.khronos.org/OpenCL/sdk/3.0/docs/man/html/clReleaseCommandBufferKHR.html
+// Extension: KhrCommandBufferExtensionName
+func (ext *ExtensionCommandBufferKhr) ReleaseCommandBuffer(commandBuffer CommandBufferKhr) error {
+	if (ext == nil) || (ext.clReleaseCommandBufferKhr == nil) {
+		return ErrExtensionNotLoaded
+	}
+	status := C.cl30ExtReleaseCommandBufferKHR(ext.clReleaseCommandBufferKhr, commandBuffer.handle())
+	if status != C.CL_SUCCESS {
+		return StatusError(status)
+	}
+	return nil
+}
+
+// EnqueueCommandBuffer enqueues a finalized command-buffer for execution, replaying all recorded
+// commands with a single call.
+//
+// The commandQueues argument may be empty to use the queues the command-buffer was recorded for;
+// otherwise it must provide a compatible queue per queue used during recording.
+//
+// See also: https://registry.khronos.org/OpenCL/sdk/3.0/docs/man/html/clEnqueueCommandBufferKHR.html
+// Extension: KhrCommandBufferExtensionName
+func (ext *ExtensionCommandBufferKhr) EnqueueCommandBuffer(commandQueues []CommandQueue, commandBuffer CommandBufferKhr,
+	waitList []Event, event *Event) error {
+	if (ext == nil) || (ext.clEnqueueCommandBufferKhr == nil) {
+		return ErrExtensionNotLoaded
+	}
+	var rawQueues unsafe.Pointer
+	if len(commandQueues) > 0 {
+		rawQueues = unsafe.Pointer(&commandQueues[0])
+	}
+	var rawWaitList unsafe.Pointer
+	if len(waitList) > 0 {
+		rawWaitList = unsafe.Pointer(&waitList[0])
+	}
+	status := C.cl30ExtEnqueueCommandBufferKHR(
+		ext.clEnqueueCommandBufferKhr,
+		C.cl_uint(len(commandQueues)),
+		(*C.cl_command_queue)(rawQueues),
+		commandBuffer.handle(),
+		C.cl_uint(len(waitList)),
+		(*C.cl_event)(rawWaitList),
+		(*C.cl_event)(unsafe.Pointer(event)))
+	if status != C.CL_SUCCESS {
+		return StatusError(status)
+	}
+	trackEventOut(event)
+	return nil
+}
+
+// CommandNDRangeKernel records a kernel execution command into the command-buffer.
+//
+// The commandQueue may be zero for command-buffers recording for a single queue.
+// The kernel arguments in effect at recording time are captured. The optional syncPoint receives
+// an identifier for the recorded command, to be referenced in the syncPointWaitList of later
+// recordings.
+//
+// See also: https://registry.khronos.org/OpenCL/sdk/3.0/docs/man/html/clCommandNDRangeKernelKHR.html
+// Extension: KhrCommandBufferExtensionName
+func (ext *ExtensionCommandBufferKhr) CommandNDRangeKernel(commandBuffer CommandBufferKhr, commandQueue CommandQueue,
+	kernel Kernel, workDimensions []WorkDimension, syncPointWaitList []SyncPointKhr, syncPoint *SyncPointKhr) error {
+	if (ext == nil) || (ext.clCommandNDRangeKernelKhr == nil) {
+		return ErrExtensionNotLoaded
+	}
+	globalWorkOffsets := make([]uintptr, len(workDimensions))
+	globalWorkSizes := make([]uintptr, len(workDimensions))
+	localWorkSizes := make([]uintptr, len(workDimensions))
+	for i, dimension := range workDimensions {
+		globalWorkOffsets[i] = dimension.GlobalOffset
+		globalWorkSizes[i] = dimension.GlobalSize
+		localWorkSizes[i] = dimension.LocalSize
+	}
+	var rawSyncPointWaitList unsafe.Pointer
+	if len(syncPointWaitList) > 0 {
+		rawSyncPointWaitList = unsafe.Pointer(&syncPointWaitList[0])
+	}
+	status := C.cl30ExtCommandNDRangeKernelKHR(
+		ext.clCommandNDRangeKernelKhr,
+		commandBuffer.handle(),
+		commandQueue.handle(),
+		nil,
+		kernel.handle(),
+		C.cl_uint(len(workDimensions)),
+		(*C.size_t)(unsafe.Pointer(&globalWorkOffsets[0])),
+		(*C.size_t)(unsafe.Pointer(&globalWorkSizes[0])),
+		(*C.size_t)(unsafe.Pointer(&localWorkSizes[0])),
+		C.cl_uint(len(syncPointWaitList)),
+		(*C.cl30SyncPointKhr)(rawSyncPointWaitList),
+		(*C.cl30SyncPointKhr)(unsafe.Pointer(syncPoint)),
+		nil)
+	if status != C.CL_SUCCESS {
+		return StatusError(status)
+	}
+	return nil
+}
+
+// CommandBarrierWithWaitList records a barrier command into the command-buffer.
+// The barrier either depends on the given sync points, or - with an empty list - on all
+// previously recorded commands.
+//
+// See also: https://registry.khronos.org/OpenCL/sdk/3.0/docs/man/html/clCommandBarrierWithWaitListKHR.html
+// Extension: KhrCommandBufferExtensionName
+func (ext *ExtensionCommandBufferKhr) CommandBarrierWithWaitList(commandBuffer CommandBufferKhr, commandQueue CommandQueue,
+	syncPointWaitList []SyncPointKhr, syncPoint *SyncPointKhr) error {
+	if (ext == nil) || (ext.clCommandBarrierWithWaitListKhr == nil) {
+		return ErrExtensionNotLoaded
+	}
+	var rawSyncPointWaitList unsafe.Pointer
+	if len(syncPointWaitList) > 0 {
+		rawSyncPointWaitList = unsafe.Pointer(&syncPointWaitList[0])
+	}
+	status := C.cl30ExtCommandBarrierWithWaitListKHR(
+		ext.clCommandBarrierWithWaitListKhr,
+		commandBuffer.handle(),
+		commandQueue.handle(),
+		nil,
+		C.cl_uint(len(syncPointWaitList)),
+		(*C.cl30SyncPointKhr)(rawSyncPointWaitList),
+		(*C.cl30SyncPointKhr)(unsafe.Pointer(syncPoint)),
+		nil)
+	if status != C.CL_SUCCESS {
+		return StatusError(status)
+	}
+	return nil
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "api.h"
+
+// Local type definitions for the "cl_khr_command_buffer" extension.
+// They are deliberately independent of the - potentially absent or provisional - definitions in
+// cl_ext.h, as the extension entry points are resolved at runtime via
+// clGetExtensionFunctionAddressForPlatform() anyway.
+typedef struct _cl30CommandBufferKhrRec *cl30CommandBufferKhr;
+typedef cl_uint cl30SyncPointKhr;
+typedef cl_properties cl30CommandBufferPropertiesKhr;
+
+cl30CommandBufferKhr cl30ExtCreateCommandBufferKHR(void *fn, cl_uint numQueues, cl_command_queue const *queues,
+    cl30CommandBufferPropertiesKhr const *properties, cl_int *errcodeReturn);
+cl_int cl30ExtFinalizeCommandBufferKHR(void *fn, cl30CommandBufferKhr commandBuffer);
+cl_int cl30ExtRetainCommandBufferKHR(void *fn, cl30CommandBufferKhr commandBuffer);
+cl_int cl30ExtReleaseCommandBufferKHR(void *fn, cl30CommandBufferKhr commandBuffer);
+cl_int cl30ExtEnqueueCommandBufferKHR(void *fn, cl_uint numQueues, cl_command_queue *queues,
+    cl30CommandBufferKhr commandBuffer, cl_uint waitListCount, cl_event const *waitList, cl_event *event);
+cl_int cl30ExtCommandNDRangeKernelKHR(void *fn, cl30CommandBufferKhr commandBuffer, cl_command_queue commandQueue,
+    void const *properties, cl_kernel kernel, cl_uint workDim,
+    size_t const *globalWorkOffset, size_t const *globalWorkSize, size_t const *localWorkSize,
+    cl_uint syncPointWaitListCount, cl30SyncPointKhr const *syncPointWaitList, cl30SyncPointKhr *syncPoint,
+    void *mutableHandle);
+cl_int cl30ExtCommandBarrierWithWaitListKHR(void *fn, cl30CommandBufferKhr commandBuffer, cl_command_queue commandQueue,
+    void const *properties, cl_uint syncPointWaitListCount, cl30SyncPointKhr const *syncPointWaitList,
+    cl30SyncPointKhr *syncPoint, void *mutableHandle);
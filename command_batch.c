@@ -0,0 +1,46 @@
+#include "command_batch.h"
+
+cl_int cl30EnqueueBatch(cl_command_queue commandQueue, cl30BatchCommand *commands, cl_uint commandCount, cl_uint *failureIndex)
+{
+    cl_uint i;
+    for (i = 0; i < commandCount; i++)
+    {
+        cl30BatchCommand *command = &commands[i];
+        cl_int status;
+        switch (command->commandType)
+        {
+        case CL30_BATCH_COMMAND_NDRANGE_KERNEL:
+            status = clEnqueueNDRangeKernel(commandQueue, command->kernel, command->workDim,
+                command->globalWorkOffset, command->globalWorkSize, command->localWorkSize,
+                0, NULL, NULL);
+            break;
+        case CL30_BATCH_COMMAND_READ_BUFFER:
+            status = clEnqueueReadBuffer(commandQueue, command->srcMem, command->blocking,
+                command->srcOffset, command->size, (void *)(command->hostPtr),
+                0, NULL, NULL);
+            break;
+        case CL30_BATCH_COMMAND_WRITE_BUFFER:
+            status = clEnqueueWriteBuffer(commandQueue, command->dstMem, command->blocking,
+                command->dstOffset, command->size, (void const *)(command->hostPtr),
+                0, NULL, NULL);
+            break;
+        case CL30_BATCH_COMMAND_COPY_BUFFER:
+            status = clEnqueueCopyBuffer(commandQueue, command->srcMem, command->dstMem,
+                command->srcOffset, command->dstOffset, command->size,
+                0, NULL, NULL);
+            break;
+        case CL30_BATCH_COMMAND_MARKER:
+            status = clEnqueueMarkerWithWaitList(commandQueue, 0, NULL, NULL);
+            break;
+        default:
+            status = CL_INVALID_VALUE;
+            break;
+        }
+        if (status != CL_SUCCESS)
+        {
+            *failureIndex = i;
+            return status;
+        }
+    }
+    return CL_SUCCESS;
+}
@@ -0,0 +1,125 @@
+package cl30
+
+// #include "command_batch.h"
+import "C"
+import "unsafe"
+
+// batchMaxWorkDimensions is the number of work dimensions a recorded kernel command can hold.
+const batchMaxWorkDimensions = 3
+
+// CommandBatch records a sequence of enqueue operations in a flat host-side array and submits them
+// through a single cgo crossing.
+//
+// Every Enqueue* function of this package performs one cgo transition per call. For workloads that
+// enqueue large amounts of small commands, the transition overhead can dominate over the actual
+// driver cost. A CommandBatch amortizes this overhead by looping over the recorded commands on the
+// C side of the boundary.
+//
+// Recorded commands are submitted without individual wait lists or result events; they execute in
+// the order of the command-queue. Use RecordMarker() combined with an in-order queue, or a final
+// blocking read, to synchronize with the completion of a batch.
+//
+// The zero value of CommandBatch is ready for use. A CommandBatch is not safe for concurrent use.
+type CommandBatch struct {
+	commands []C.cl30BatchCommand
+}
+
+// Len returns the number of currently recorded commands.
+func (batch *CommandBatch) Len() int {
+	return len(batch.commands)
+}
+
+// Reset discards all recorded commands while keeping the allocated storage for reuse.
+func (batch *CommandBatch) Reset() {
+	batch.commands = batch.commands[:0]
+}
+
+// RecordNDRangeKernel records a command to execute a kernel on a device.
+// The kernel arguments must be set before the batch is submitted and must not change until then.
+//
+// Up to three work dimensions are supported; ErrInvalidWorkDimension is returned for other counts.
+func (batch *CommandBatch) RecordNDRangeKernel(kernel Kernel, workDimensions []WorkDimension) error {
+	if (len(workDimensions) == 0) || (len(workDimensions) > batchMaxWorkDimensions) {
+		return ErrInvalidWorkDimension
+	}
+	var command C.cl30BatchCommand
+	command.commandType = C.CL30_BATCH_COMMAND_NDRANGE_KERNEL
+	command.kernel = kernel.handle()
+	command.workDim = C.cl_uint(len(workDimensions))
+	for i, dimension := range workDimensions {
+		command.globalWorkOffset[i] = C.size_t(dimension.GlobalOffset)
+		command.globalWorkSize[i] = C.size_t(dimension.GlobalSize)
+		command.localWorkSize[i] = C.size_t(dimension.LocalSize)
+	}
+	batch.commands = append(batch.commands, command)
+	return nil
+}
+
+// RecordReadBuffer records a command to read from a buffer object to host memory.
+// The memory referred to by data must remain valid until the batch is submitted and the command
+// has completed.
+func (batch *CommandBatch) RecordReadBuffer(mem MemObject, blocking bool, offset, size uintptr, data unsafe.Pointer) {
+	var command C.cl30BatchCommand
+	command.commandType = C.CL30_BATCH_COMMAND_READ_BUFFER
+	command.srcMem = mem.handle()
+	command.blocking = C.cl_bool(BoolFrom(blocking))
+	command.srcOffset = C.size_t(offset)
+	command.size = C.size_t(size)
+	command.hostPtr = C.uintptr_t(uintptr(data))
+	batch.commands = append(batch.commands, command)
+}
+
+// RecordWriteBuffer records a command to write to a buffer object from host memory.
+// The memory referred to by data must remain valid until the batch is submitted and the command
+// has completed.
+func (batch *CommandBatch) RecordWriteBuffer(mem MemObject, blocking bool, offset, size uintptr, data unsafe.Pointer) {
+	var command C.cl30BatchCommand
+	command.commandType = C.CL30_BATCH_COMMAND_WRITE_BUFFER
+	command.dstMem = mem.handle()
+	command.blocking = C.cl_bool(BoolFrom(blocking))
+	command.dstOffset = C.size_t(offset)
+	command.size = C.size_t(size)
+	command.hostPtr = C.uintptr_t(uintptr(data))
+	batch.commands = append(batch.commands, command)
+}
+
+// RecordCopyBuffer records a command to copy from one buffer object to another.
+func (batch *CommandBatch) RecordCopyBuffer(src, dst MemObject, srcOffset, dstOffset, size uintptr) {
+	var command C.cl30BatchCommand
+	command.commandType = C.CL30_BATCH_COMMAND_COPY_BUFFER
+	command.srcMem = src.handle()
+	command.dstMem = dst.handle()
+	command.srcOffset = C.size_t(srcOffset)
+	command.dstOffset = C.size_t(dstOffset)
+	command.size = C.size_t(size)
+	batch.commands = append(batch.commands, command)
+}
+
+// RecordMarker records a marker command which waits for all previously enqueued commands to complete.
+func (batch *CommandBatch) RecordMarker() {
+	var command C.cl30BatchCommand
+	command.commandType = C.CL30_BATCH_COMMAND_MARKER
+	batch.commands = append(batch.commands, command)
+}
+
+// Submit enqueues all recorded commands on the given command-queue with a single cgo crossing.
+// The recorded commands remain in the batch; call Reset() to record a new sequence, or Submit()
+// again to re-enqueue the same sequence.
+//
+// The returned number is the count of successfully enqueued commands. If an error is returned,
+// the number identifies the index of the command that failed.
+func (batch *CommandBatch) Submit(commandQueue CommandQueue) (int, error) {
+	if len(batch.commands) == 0 {
+		return 0, nil
+	}
+	var failureIndex C.cl_uint
+	status := C.cl30EnqueueBatch(
+		commandQueue.handle(),
+		&batch.commands[0],
+		C.cl_uint(len(batch.commands)),
+		&failureIndex)
+	if status != C.CL_SUCCESS {
+		return int(failureIndex), StatusError(status)
+	}
+	return len(batch.commands), nil
+}
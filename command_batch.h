@@ -0,0 +1,34 @@
+#pragma once
+
+#include "api.h"
+
+// Command type identifiers for the commandType field of cl30BatchCommand.
+#define CL30_BATCH_COMMAND_NDRANGE_KERNEL 1
+#define CL30_BATCH_COMMAND_READ_BUFFER 2
+#define CL30_BATCH_COMMAND_WRITE_BUFFER 3
+#define CL30_BATCH_COMMAND_COPY_BUFFER 4
+#define CL30_BATCH_COMMAND_MARKER 5
+
+// cl30BatchCommand describes one recorded enqueue operation of a command batch.
+// The structure is a flat superset of the parameters of all supported commands so that an array of
+// them can be filled on the Go side and submitted with a single cgo crossing.
+// The hostPtr field is typed as an integer to keep the structure free of pointer fields from the
+// perspective of the Go runtime.
+typedef struct
+{
+    cl_uint commandType;
+    cl_kernel kernel;
+    cl_mem srcMem;
+    cl_mem dstMem;
+    cl_uint workDim;
+    size_t globalWorkOffset[3];
+    size_t globalWorkSize[3];
+    size_t localWorkSize[3];
+    size_t srcOffset;
+    size_t dstOffset;
+    size_t size;
+    cl_bool blocking;
+    uintptr_t hostPtr;
+} cl30BatchCommand;
+
+cl_int cl30EnqueueBatch(cl_command_queue commandQueue, cl30BatchCommand *commands, cl_uint commandCount, cl_uint *failureIndex);
@@ -0,0 +1,28 @@
+#include "api.h"
+
+cl_int cl30FlushQueues(cl_command_queue *queues, cl_uint count, cl_int finish)
+{
+    cl_int firstError = CL_SUCCESS;
+    cl_uint i;
+    for (i = 0; i < count; i++)
+    {
+        cl_int status;
+        if (queues[i] == NULL)
+        {
+            continue;
+        }
+        if (finish != 0)
+        {
+            status = clFinish(queues[i]);
+        }
+        else
+        {
+            status = clFlush(queues[i]);
+        }
+        if ((status != CL_SUCCESS) && (firstError == CL_SUCCESS))
+        {
+            firstError = status;
+        }
+    }
+    return firstError;
+}
@@ -108,7 +108,7 @@ func CreateCommandQueueWithProperties(context Context, deviceID DeviceID, proper
 	if status != C.CL_SUCCESS {
 		return 0, StatusError(status)
 	}
-	return CommandQueue(*((*uintptr)(unsafe.Pointer(&commandQueue)))), nil
+	return trackedCommandQueue(commandQueue), nil
 }
 
 // RetainCommandQueue increments the commandQueue reference count.
@@ -125,6 +125,7 @@ func RetainCommandQueue(commandQueue CommandQueue) error {
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackCreate(HandleKindCommandQueue, uintptr(commandQueue))
 	return nil
 }
 
@@ -141,6 +142,7 @@ func ReleaseCommandQueue(commandQueue CommandQueue) error {
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackRelease(HandleKindCommandQueue, uintptr(commandQueue))
 	return nil
 }
 
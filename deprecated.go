@@ -64,6 +64,7 @@ func EnqueueTask(commandQueue CommandQueue, kernel Kernel, waitList []Event, eve
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
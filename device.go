@@ -966,9 +966,7 @@ func DeviceInfo(id DeviceID, paramName DeviceInfoName, paramSize uintptr, paramV
 // This function does not verify the queried information is indeed of type string. It assumes the information is
 // a NUL terminated raw string and will extract the bytes as characters before that.
 func DeviceInfoString(id DeviceID, paramName DeviceInfoName) (string, error) {
-	return queryString(func(paramSize uintptr, paramValue unsafe.Pointer) (uintptr, error) {
-		return DeviceInfo(id, paramName, paramSize, paramValue)
-	})
+	return queryStringShim(queryTargetDevice, unsafe.Pointer(id.handle()), nil, uint32(paramName))
 }
 
 // DeviceAndHostTimer returns a reasonably synchronized pair of timestamps from the device timer and the host timer
@@ -0,0 +1,99 @@
+package cl30
+
+// #include "api.h"
+import "C"
+import "unsafe"
+
+// DeviceProperties is a snapshot of commonly used device details.
+//
+// Scheduling and allocation decisions often consult the same device limits over and over. Each
+// DeviceInfo() query is a separate cgo call, so code that re-queries per decision pays the
+// transition cost repeatedly. QueryDeviceProperties() gathers the details once into a plain Go
+// structure that can be consulted without further calls.
+//
+// The snapshot reflects the state of the device at query time; the values do not change for the
+// lifetime of a device.
+type DeviceProperties struct {
+	// Name is the human-readable device identification, as per DeviceNameInfo.
+	Name string
+	// Vendor is the human-readable vendor identification, as per DeviceVendorInfo.
+	Vendor string
+	// Version is the OpenCL version supported by the device, as per DeviceVersionInfo.
+	Version string
+	// DriverVersion is the vendor-specific software driver version, as per DriverVersionInfo.
+	DriverVersion string
+	// Extensions is the space-separated list of supported extension names, as per DeviceExtensionsInfo.
+	Extensions string
+	// Type describes the type or types of the device, as per DeviceTypeInfo.
+	Type DeviceTypeFlags
+	// MaxComputeUnits is the number of parallel compute units, as per DeviceMaxComputeUnitsInfo.
+	MaxComputeUnits uint32
+	// MaxWorkGroupSize is the maximum number of work-items in a work-group, as per DeviceMaxWorkGroupSizeInfo.
+	MaxWorkGroupSize uintptr
+	// MaxWorkItemSizes is the maximum number of work-items per dimension, as per DeviceMaxWorkItemSizesInfo.
+	MaxWorkItemSizes []uintptr
+	// GlobalMemSize is the size of global device memory in bytes, as per DeviceGlobalMemSizeInfo.
+	GlobalMemSize uint64
+	// LocalMemSize is the size of the local memory region in bytes, as per DeviceLocalMemSizeInfo.
+	LocalMemSize uint64
+	// MaxMemAllocSize is the maximum size of a memory object allocation in bytes, as per DeviceMaxMemAllocSizeInfo.
+	MaxMemAllocSize uint64
+	// SvmCapabilities describes the supported shared virtual memory allocation types, as per
+	// DeviceSvmCapabilitiesInfo. The field is zero for devices that do not support the query.
+	SvmCapabilities DeviceSvmCapabilitiesFlags
+}
+
+// QueryDeviceProperties retrieves a DeviceProperties snapshot for the given device.
+// All underlying DeviceInfo() queries are performed once within this call.
+func QueryDeviceProperties(id DeviceID) (*DeviceProperties, error) {
+	var properties DeviceProperties
+	var err error
+	if properties.Name, err = DeviceInfoString(id, DeviceNameInfo); err != nil {
+		return nil, err
+	}
+	if properties.Vendor, err = DeviceInfoString(id, DeviceVendorInfo); err != nil {
+		return nil, err
+	}
+	if properties.Version, err = DeviceInfoString(id, DeviceVersionInfo); err != nil {
+		return nil, err
+	}
+	if properties.DriverVersion, err = DeviceInfoString(id, DriverVersionInfo); err != nil {
+		return nil, err
+	}
+	if properties.Extensions, err = DeviceInfoString(id, DeviceExtensionsInfo); err != nil {
+		return nil, err
+	}
+	if _, err = DeviceInfo(id, DeviceTypeInfo, unsafe.Sizeof(properties.Type), unsafe.Pointer(&properties.Type)); err != nil {
+		return nil, err
+	}
+	if _, err = DeviceInfo(id, DeviceMaxComputeUnitsInfo, unsafe.Sizeof(properties.MaxComputeUnits), unsafe.Pointer(&properties.MaxComputeUnits)); err != nil {
+		return nil, err
+	}
+	if _, err = DeviceInfo(id, DeviceMaxWorkGroupSizeInfo, unsafe.Sizeof(properties.MaxWorkGroupSize), unsafe.Pointer(&properties.MaxWorkGroupSize)); err != nil {
+		return nil, err
+	}
+	var maxWorkItemDimensions uint32
+	if _, err = DeviceInfo(id, DeviceMaxWorkItemDimensionsInfo, unsafe.Sizeof(maxWorkItemDimensions), unsafe.Pointer(&maxWorkItemDimensions)); err != nil {
+		return nil, err
+	}
+	if maxWorkItemDimensions > 0 {
+		properties.MaxWorkItemSizes = make([]uintptr, maxWorkItemDimensions)
+		_, err = DeviceInfo(id, DeviceMaxWorkItemSizesInfo,
+			uintptr(maxWorkItemDimensions)*unsafe.Sizeof(uintptr(0)), unsafe.Pointer(&properties.MaxWorkItemSizes[0]))
+		if err != nil {
+			return nil, err
+		}
+	}
+	if _, err = DeviceInfo(id, DeviceGlobalMemSizeInfo, unsafe.Sizeof(properties.GlobalMemSize), unsafe.Pointer(&properties.GlobalMemSize)); err != nil {
+		return nil, err
+	}
+	if _, err = DeviceInfo(id, DeviceLocalMemSizeInfo, unsafe.Sizeof(properties.LocalMemSize), unsafe.Pointer(&properties.LocalMemSize)); err != nil {
+		return nil, err
+	}
+	if _, err = DeviceInfo(id, DeviceMaxMemAllocSizeInfo, unsafe.Sizeof(properties.MaxMemAllocSize), unsafe.Pointer(&properties.MaxMemAllocSize)); err != nil {
+		return nil, err
+	}
+	// The SVM capabilities query is not supported on all devices; a failure leaves the field at zero.
+	_, _ = DeviceInfo(id, DeviceSvmCapabilitiesInfo, unsafe.Sizeof(properties.SvmCapabilities), unsafe.Pointer(&properties.SvmCapabilities))
+	return &properties, nil
+}
@@ -0,0 +1,221 @@
+package cl30
+
+import (
+	"sync"
+)
+
+// DispatchWork is one unit of work for a Dispatcher. The function enqueues its commands - kernel
+// launches, transfers - on the given command-queue.
+//
+// If the function returns a non-zero event, the dispatcher uses it to track the outstanding-command
+// depth of the queue and releases the event on completion. Returning a zero event marks the work
+// as complete upon return of the function.
+type DispatchWork func(commandQueue CommandQueue) (Event, error)
+
+// dispatcherWorker drives the command-queue of one device.
+type dispatcherWorker struct {
+	device DeviceID
+	queue  CommandQueue
+	// backlog is guarded by the dispatcher mutex.
+	backlog []DispatchWork
+	// inFlight counts work items being executed plus enqueued commands whose completion event
+	// has not yet fired. It is guarded by the dispatcher mutex, so that Wait() cannot miss the
+	// wake-up of the final decrement.
+	inFlight int
+}
+
+// load returns the current scheduling weight of the worker.
+// The caller must hold the dispatcher mutex.
+func (worker *dispatcherWorker) load() int {
+	return len(worker.backlog) + worker.inFlight
+}
+
+// Dispatcher balances work items across the command-queues of multiple devices.
+//
+// One queue and one worker goroutine are created per device - including sub-devices obtained from
+// CreateSubDevices(). Submitted work goes to the least-loaded queue, where load is the sum of
+// backlog length and outstanding-command depth tracked via event completion. Idle workers steal
+// from the longest backlog, so a device that is slowed down externally - for example by also
+// serving a display - automatically sheds work to its peers.
+//
+// A Dispatcher is safe for concurrent use.
+type Dispatcher struct {
+	mutex   sync.Mutex
+	cond    *sync.Cond
+	workers []*dispatcherWorker
+	closing bool
+	wg      sync.WaitGroup
+
+	// OnError, if not nil, receives errors returned by work items or by completion tracking.
+	// Set it before the first Submit(); the callback may be invoked from multiple goroutines.
+	OnError func(error)
+}
+
+// NewDispatcher creates one command-queue per device in the given context and starts a worker
+// goroutine for each. The properties are applied to every created queue.
+// At least one device is required; ErrInvalidValue is returned for an empty device list.
+func NewDispatcher(context Context, devices []DeviceID, properties ...CommandQueueProperty) (*Dispatcher, error) {
+	if len(devices) == 0 {
+		return nil, ErrInvalidValue
+	}
+	dispatcher := &Dispatcher{}
+	dispatcher.cond = sync.NewCond(&dispatcher.mutex)
+	for _, device := range devices {
+		queue, err := CreateCommandQueueWithProperties(context, device, properties...)
+		if err != nil {
+			_ = dispatcher.Close()
+			return nil, err
+		}
+		dispatcher.workers = append(dispatcher.workers, &dispatcherWorker{device: device, queue: queue})
+	}
+	for _, worker := range dispatcher.workers {
+		dispatcher.wg.Add(1)
+		go dispatcher.run(worker)
+	}
+	return dispatcher, nil
+}
+
+// Submit hands a work item to the least-loaded worker. It returns immediately; the work is
+// executed asynchronously on the worker goroutine that picks it up.
+func (dispatcher *Dispatcher) Submit(work DispatchWork) {
+	dispatcher.mutex.Lock()
+	target := dispatcher.workers[0]
+	for _, worker := range dispatcher.workers[1:] {
+		if worker.load() < target.load() {
+			target = worker
+		}
+	}
+	target.backlog = append(target.backlog, work)
+	dispatcher.mutex.Unlock()
+	// Broadcast instead of Signal: waiters include both idle workers and Wait() callers.
+	dispatcher.cond.Broadcast()
+}
+
+// Wait blocks until all submitted work has been executed and all tracked completion events fired.
+func (dispatcher *Dispatcher) Wait() {
+	dispatcher.mutex.Lock()
+	defer dispatcher.mutex.Unlock()
+	for !dispatcher.idleLocked() {
+		dispatcher.cond.Wait()
+	}
+}
+
+// Close stops the worker goroutines and releases the command-queues. The workers first drain
+// and execute the remaining backlogs; completion events of commands still in flight are not
+// waited for - call Wait() first for a full drain. The first encountered error is returned.
+func (dispatcher *Dispatcher) Close() error {
+	dispatcher.mutex.Lock()
+	dispatcher.closing = true
+	dispatcher.mutex.Unlock()
+	dispatcher.cond.Broadcast()
+	dispatcher.wg.Wait()
+	var firstErr error
+	for _, worker := range dispatcher.workers {
+		if err := ReleaseCommandQueue(worker.queue); (err != nil) && (firstErr == nil) {
+			firstErr = err
+		}
+	}
+	dispatcher.workers = nil
+	return firstErr
+}
+
+// idleLocked reports whether no work is queued or in flight.
+// The caller must hold the dispatcher mutex.
+func (dispatcher *Dispatcher) idleLocked() bool {
+	for _, worker := range dispatcher.workers {
+		if worker.load() > 0 {
+			return false
+		}
+	}
+	return true
+}
+
+// run is the loop of one worker goroutine.
+func (dispatcher *Dispatcher) run(worker *dispatcherWorker) {
+	defer dispatcher.wg.Done()
+	for {
+		dispatcher.mutex.Lock()
+		var work DispatchWork
+		for {
+			work = dispatcher.takeLocked(worker)
+			if (work != nil) || dispatcher.closing {
+				break
+			}
+			dispatcher.cond.Wait()
+		}
+		if work != nil {
+			// Count the item as in flight before the backlog slot is given up, so Wait()
+			// never observes the gap between taking and executing the work.
+			worker.inFlight++
+		}
+		dispatcher.mutex.Unlock()
+		if work == nil {
+			return
+		}
+		dispatcher.execute(worker, work)
+	}
+}
+
+// takeLocked removes the next work item for the worker: first from its own backlog, then by
+// stealing from the longest backlog of its peers. The caller must hold the dispatcher mutex.
+func (dispatcher *Dispatcher) takeLocked(worker *dispatcherWorker) DispatchWork {
+	if len(worker.backlog) > 0 {
+		work := worker.backlog[0]
+		worker.backlog = worker.backlog[1:]
+		return work
+	}
+	var victim *dispatcherWorker
+	for _, other := range dispatcher.workers {
+		if (len(other.backlog) > 0) && ((victim == nil) || (len(other.backlog) > len(victim.backlog))) {
+			victim = other
+		}
+	}
+	if victim == nil {
+		return nil
+	}
+	lastIndex := len(victim.backlog) - 1
+	work := victim.backlog[lastIndex]
+	victim.backlog = victim.backlog[:lastIndex]
+	return work
+}
+
+// execute runs one work item on the queue of the worker and wires up completion tracking.
+// The caller already counted the item in the in-flight count of the worker.
+func (dispatcher *Dispatcher) execute(worker *dispatcherWorker, work DispatchWork) {
+	event, err := work(worker.queue)
+	if err != nil {
+		dispatcher.reportError(err)
+	}
+	if event == 0 {
+		dispatcher.finishWork(worker)
+		return
+	}
+	err = SetEventCallback(event, EventCommandCompleteStatus, func(completionErr error) {
+		if completionErr != nil {
+			dispatcher.reportError(completionErr)
+		}
+		_ = ReleaseEvent(event)
+		dispatcher.finishWork(worker)
+	})
+	if err != nil {
+		_ = ReleaseEvent(event)
+		dispatcher.reportError(err)
+		dispatcher.finishWork(worker)
+	}
+}
+
+// finishWork marks one work item of the worker as complete and wakes Wait() callers.
+// The decrement happens under the mutex: a broadcast of an unguarded decrement could land
+// between the predicate check of a waiter and its wait, and would be lost.
+func (dispatcher *Dispatcher) finishWork(worker *dispatcherWorker) {
+	dispatcher.mutex.Lock()
+	worker.inFlight--
+	dispatcher.mutex.Unlock()
+	dispatcher.cond.Broadcast()
+}
+
+func (dispatcher *Dispatcher) reportError(err error) {
+	if dispatcher.OnError != nil {
+		dispatcher.OnError(err)
+	}
+}
@@ -11,3 +11,52 @@ cl_int cl30SetEventCallback(cl_event event, cl_int callbackType, uintptr_t *user
 {
     return clSetEventCallback(event, callbackType, cl30CEventCallback, userData);
 }
+
+void cl30CollectProfilingSamples(cl_event *events, cl_uint count, cl_ulong *timestamps, cl_int *states)
+{
+    cl_uint i;
+    for (i = 0; i < count; i++)
+    {
+        cl_int executionStatus;
+        cl_ulong *sample = timestamps + ((size_t)(i)*4);
+        cl_int status = clGetEventInfo(events[i], CL_EVENT_COMMAND_EXECUTION_STATUS,
+            sizeof(executionStatus), &executionStatus, NULL);
+        if ((status != CL_SUCCESS) || (executionStatus > 0))
+        {
+            states[i] = (status != CL_SUCCESS) ? status : executionStatus;
+            continue;
+        }
+        status = clGetEventProfilingInfo(events[i], CL_PROFILING_COMMAND_QUEUED, sizeof(cl_ulong), &sample[0], NULL);
+        if (status == CL_SUCCESS)
+        {
+            status = clGetEventProfilingInfo(events[i], CL_PROFILING_COMMAND_SUBMIT, sizeof(cl_ulong), &sample[1], NULL);
+        }
+        if (status == CL_SUCCESS)
+        {
+            status = clGetEventProfilingInfo(events[i], CL_PROFILING_COMMAND_START, sizeof(cl_ulong), &sample[2], NULL);
+        }
+        if (status == CL_SUCCESS)
+        {
+            status = clGetEventProfilingInfo(events[i], CL_PROFILING_COMMAND_END, sizeof(cl_ulong), &sample[3], NULL);
+        }
+        states[i] = status;
+    }
+}
+
+cl_int cl30ReleaseEvents(cl_event *events, cl_uint count)
+{
+    cl_int firstError = CL_SUCCESS;
+    cl_uint i;
+    for (i = 0; i < count; i++)
+    {
+        if (events[i] != NULL)
+        {
+            cl_int status = clReleaseEvent(events[i]);
+            if ((status != CL_SUCCESS) && (firstError == CL_SUCCESS))
+            {
+                firstError = status;
+            }
+        }
+    }
+    return firstError;
+}
@@ -34,7 +34,7 @@ func CreateUserEvent(context Context) (Event, error) {
 	if status != C.CL_SUCCESS {
 		return 0, StatusError(status)
 	}
-	return Event(*((*uintptr)(unsafe.Pointer(&event)))), nil
+	return trackedEvent(event), nil
 }
 
 // SetUserEventStatus sets the execution status of a user event object.
@@ -247,6 +247,7 @@ func RetainEvent(event Event) error {
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackCreate(HandleKindEvent, uintptr(event))
 	return nil
 }
 
@@ -258,6 +259,7 @@ func ReleaseEvent(event Event) error {
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackRelease(HandleKindEvent, uintptr(event))
 	return nil
 }
 
@@ -370,6 +372,7 @@ func EnqueueMarkerWithWaitList(commandQueue CommandQueue, waitList []Event, even
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
@@ -394,5 +397,6 @@ func EnqueueBarrierWithWaitList(commandQueue CommandQueue, waitList []Event, eve
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
@@ -0,0 +1,62 @@
+package cl30
+
+// #include "api.h"
+// extern cl_int cl30ReleaseEvents(cl_event *events, cl_uint count);
+import "C"
+import "unsafe"
+
+// EventPool collects event objects of enqueued commands for deferred release in one batch.
+//
+// Commands that return an event oblige the caller to release it eventually. Releasing each event
+// individually costs one cgo crossing per event and tends to scatter the release calls across the
+// hot path. An EventPool instead hands out slots for the Enqueue* functions to fill, and
+// ReleaseAll() releases all collected events through a single C-side loop.
+//
+// The slice storage is retained across ReleaseAll() calls, so a steady-state cycle of filling and
+// releasing does not allocate.
+//
+// The zero value of EventPool is ready for use. An EventPool is not safe for concurrent use.
+type EventPool struct {
+	events []Event
+}
+
+// Next appends an empty slot to the pool and returns its address, to be passed as the event
+// parameter of an Enqueue* function. The returned pointer is only valid until the next call
+// to Next().
+func (pool *EventPool) Next() *Event {
+	pool.events = append(pool.events, 0)
+	return &pool.events[len(pool.events)-1]
+}
+
+// Events returns the currently collected events. Slots of failed enqueue operations remain zero.
+// The returned slice is only valid until the next call to Next() or ReleaseAll().
+func (pool *EventPool) Events() []Event {
+	return pool.events
+}
+
+// Len returns the number of slots handed out since the last ReleaseAll().
+func (pool *EventPool) Len() int {
+	return len(pool.events)
+}
+
+// ReleaseAll releases all collected events with a single cgo crossing and empties the pool.
+// Zero slots are skipped. In case of errors, the first encountered error is returned, yet all
+// remaining events are still released.
+func (pool *EventPool) ReleaseAll() error {
+	if len(pool.events) == 0 {
+		return nil
+	}
+	status := C.cl30ReleaseEvents((*C.cl_event)(unsafe.Pointer(&pool.events[0])), C.cl_uint(len(pool.events)))
+	if handleTrackingEnabled() {
+		for _, event := range pool.events {
+			if event != 0 {
+				trackRelease(HandleKindEvent, uintptr(event))
+			}
+		}
+	}
+	pool.events = pool.events[:0]
+	if status != C.CL_SUCCESS {
+		return StatusError(status)
+	}
+	return nil
+}
@@ -0,0 +1,56 @@
+package cl30
+
+// EventCompletion registers a completion callback for the event and returns a channel that
+// receives the result once the associated command has completed.
+//
+// WaitForEvents() blocks inside the driver and thereby pins an OS thread for the duration of the
+// wait. At high concurrency this forces the Go runtime to spawn additional threads. The channel
+// returned here is fed from the driver's callback thread instead, so a waiting goroutine simply
+// parks and the OS thread stays available to the scheduler. The channel can also be combined with
+// select statements for timeouts or cancellation.
+//
+// The channel is buffered; the result does not need to be received for the callback to complete.
+// A nil value is delivered on successful completion, an error describes an abnormal termination.
+func EventCompletion(event Event) (<-chan error, error) {
+	completion := make(chan error, 1)
+	err := SetEventCallback(event, EventCommandCompleteStatus, func(err error) {
+		completion <- err
+	})
+	if err != nil {
+		return nil, err
+	}
+	return completion, nil
+}
+
+// AwaitEvents waits for the commands identified by all given events to complete, without pinning
+// an OS thread for the duration of the wait.
+//
+// It is the goroutine-friendly equivalent of WaitForEvents(): completion is signalled through
+// event callbacks, and the calling goroutine parks until all of them fired.
+//
+// The first encountered error is returned - be it from callback registration or from an
+// abnormally terminated command. Callbacks that were already registered are awaited in any case.
+func AwaitEvents(events []Event) error {
+	if len(events) == 0 {
+		return nil
+	}
+	completions := make(chan error, len(events))
+	var firstErr error
+	registered := 0
+	for _, event := range events {
+		err := SetEventCallback(event, EventCommandCompleteStatus, func(err error) {
+			completions <- err
+		})
+		if err != nil {
+			firstErr = err
+			break
+		}
+		registered++
+	}
+	for i := 0; i < registered; i++ {
+		if err := <-completions; (err != nil) && (firstErr == nil) {
+			firstErr = err
+		}
+	}
+	return firstErr
+}
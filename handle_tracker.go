@@ -0,0 +1,236 @@
+package cl30
+
+// #include "api.h"
+import "C"
+import (
+	"fmt"
+	"runtime"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"unsafe"
+)
+
+// HandleKind identifies the object kind of a tracked handle.
+type HandleKind int
+
+const (
+	// HandleKindMemObject counts buffer, sub-buffer, image, and pipe objects.
+	HandleKindMemObject HandleKind = iota
+	// HandleKindEvent counts event objects, both user events and events returned by Enqueue* functions.
+	HandleKindEvent
+	// HandleKindKernel counts kernel objects.
+	HandleKindKernel
+	// HandleKindCommandQueue counts command-queue objects.
+	HandleKindCommandQueue
+
+	handleKindCount
+)
+
+// String returns a readable name of the handle kind.
+func (kind HandleKind) String() string {
+	switch kind {
+	case HandleKindMemObject:
+		return "MemObject"
+	case HandleKindEvent:
+		return "Event"
+	case HandleKindKernel:
+		return "Kernel"
+	case HandleKindCommandQueue:
+		return "CommandQueue"
+	default:
+		return fmt.Sprintf("HandleKind(%d)", int(kind))
+	}
+}
+
+// handleTrackerShardCount spreads the counters over several cache lines to keep concurrent
+// creators and releasers from contending on one. Must be a power of two.
+const handleTrackerShardCount = 16
+
+// handleTrackerShard holds one set of per-kind counters, padded to a cache line.
+type handleTrackerShard struct {
+	counts [handleKindCount]int64
+	_      [64 - (handleKindCount*8)%64]byte
+}
+
+// handleOrigin describes one live handle in debug mode.
+type handleOrigin struct {
+	kind HandleKind
+	site string
+}
+
+var handleTracker struct {
+	enabled int32
+	debug   int32
+	shards  [handleTrackerShardCount]handleTrackerShard
+
+	mutex   sync.Mutex
+	origins map[uintptr]handleOrigin
+}
+
+// StartHandleTracking enables live-handle accounting.
+//
+// While enabled, creations and releases of memory objects, events, kernels, and command-queues
+// maintain sharded atomic counters; the cost on the hot path is one atomic addition.
+// With debug set, every live handle additionally records the call site that created it, at the
+// cost of a lock and a map insert per creation - intended for tracking a leak down, not for
+// production use.
+//
+// Handles created before tracking started are not accounted; releasing them while tracking
+// drives the counters negative, which in itself is a hint that untracked objects are still
+// alive. Start tracking before creating the objects of interest for exact counts.
+func StartHandleTracking(debug bool) {
+	handleTracker.mutex.Lock()
+	defer handleTracker.mutex.Unlock()
+	handleTracker.origins = make(map[uintptr]handleOrigin)
+	debugValue := int32(0)
+	if debug {
+		debugValue = 1
+	}
+	atomic.StoreInt32(&handleTracker.debug, debugValue)
+	atomic.StoreInt32(&handleTracker.enabled, 1)
+}
+
+// StopHandleTracking disables live-handle accounting and resets all recorded state.
+func StopHandleTracking() {
+	atomic.StoreInt32(&handleTracker.enabled, 0)
+	atomic.StoreInt32(&handleTracker.debug, 0)
+	handleTracker.mutex.Lock()
+	defer handleTracker.mutex.Unlock()
+	handleTracker.origins = nil
+	for shard := range handleTracker.shards {
+		for kind := range handleTracker.shards[shard].counts {
+			atomic.StoreInt64(&handleTracker.shards[shard].counts[kind], 0)
+		}
+	}
+}
+
+// HandleTrackingSnapshot reports the live handles at one point in time; see TrackedHandles().
+type HandleTrackingSnapshot struct {
+	// Live holds the number of live handles per kind: creations minus releases while tracking
+	// was enabled, with retains counting as creations.
+	Live map[HandleKind]int64
+	// MemObjectBytes sums the MemSizeInfo of all live memory objects. Only in debug mode.
+	MemObjectBytes uint64
+	// CreationSites holds the number of live handles per creating call site. Only in debug mode.
+	CreationSites map[string]int
+}
+
+// TrackedHandles returns a snapshot of the current live-handle accounting.
+func TrackedHandles() HandleTrackingSnapshot {
+	snapshot := HandleTrackingSnapshot{Live: make(map[HandleKind]int64, handleKindCount)}
+	for shard := range handleTracker.shards {
+		for kind := range handleTracker.shards[shard].counts {
+			snapshot.Live[HandleKind(kind)] += atomic.LoadInt64(&handleTracker.shards[shard].counts[kind])
+		}
+	}
+	if atomic.LoadInt32(&handleTracker.debug) == 0 {
+		return snapshot
+	}
+	handleTracker.mutex.Lock()
+	origins := make(map[uintptr]handleOrigin, len(handleTracker.origins))
+	for handle, origin := range handleTracker.origins {
+		origins[handle] = origin
+	}
+	handleTracker.mutex.Unlock()
+	snapshot.CreationSites = make(map[string]int, len(origins))
+	for handle, origin := range origins {
+		snapshot.CreationSites[origin.site]++
+		if origin.kind == HandleKindMemObject {
+			var size uintptr
+			_, err := MemObjectInfo(MemObject(handle), MemSizeInfo, unsafe.Sizeof(size), unsafe.Pointer(&size))
+			if err == nil {
+				snapshot.MemObjectBytes += uint64(size)
+			}
+		}
+	}
+	return snapshot
+}
+
+// handleTrackingEnabled reports whether accounting is active.
+func handleTrackingEnabled() bool {
+	return atomic.LoadInt32(&handleTracker.enabled) != 0
+}
+
+// trackCreate accounts one created (or retained) handle.
+func trackCreate(kind HandleKind, handle uintptr) {
+	if !handleTrackingEnabled() {
+		return
+	}
+	shard := &handleTracker.shards[(handle>>4)%handleTrackerShardCount]
+	atomic.AddInt64(&shard.counts[kind], 1)
+	if atomic.LoadInt32(&handleTracker.debug) != 0 {
+		site := trackingSite()
+		handleTracker.mutex.Lock()
+		if handleTracker.origins != nil {
+			handleTracker.origins[handle] = handleOrigin{kind: kind, site: site}
+		}
+		handleTracker.mutex.Unlock()
+	}
+}
+
+// trackRelease accounts one released handle.
+func trackRelease(kind HandleKind, handle uintptr) {
+	if !handleTrackingEnabled() {
+		return
+	}
+	shard := &handleTracker.shards[(handle>>4)%handleTrackerShardCount]
+	atomic.AddInt64(&shard.counts[kind], -1)
+	if atomic.LoadInt32(&handleTracker.debug) != 0 {
+		handleTracker.mutex.Lock()
+		delete(handleTracker.origins, handle)
+		handleTracker.mutex.Unlock()
+	}
+}
+
+// trackingSite returns the first call site outside this package.
+func trackingSite() string {
+	var pcs [10]uintptr
+	count := runtime.Callers(3, pcs[:])
+	frames := runtime.CallersFrames(pcs[:count])
+	for {
+		frame, more := frames.Next()
+		if !strings.HasPrefix(frame.Function, "github.com/opencl-go/cl30.") {
+			return fmt.Sprintf("%s:%d", frame.File, frame.Line)
+		}
+		if !more {
+			return "(unknown)"
+		}
+	}
+}
+
+// trackedMemObject converts a raw handle of a newly created memory object, accounting it.
+func trackedMemObject(mem C.cl_mem) MemObject {
+	memObject := MemObject(*((*uintptr)(unsafe.Pointer(&mem))))
+	trackCreate(HandleKindMemObject, uintptr(memObject))
+	return memObject
+}
+
+// trackedKernel converts a raw handle of a newly created kernel, accounting it.
+func trackedKernel(kernel C.cl_kernel) Kernel {
+	kernelObject := Kernel(*((*uintptr)(unsafe.Pointer(&kernel))))
+	trackCreate(HandleKindKernel, uintptr(kernelObject))
+	return kernelObject
+}
+
+// trackedCommandQueue converts a raw handle of a newly created command-queue, accounting it.
+func trackedCommandQueue(commandQueue C.cl_command_queue) CommandQueue {
+	queueObject := CommandQueue(*((*uintptr)(unsafe.Pointer(&commandQueue))))
+	trackCreate(HandleKindCommandQueue, uintptr(queueObject))
+	return queueObject
+}
+
+// trackedEvent converts a raw handle of a newly created event, accounting it.
+func trackedEvent(event C.cl_event) Event {
+	eventObject := Event(*((*uintptr)(unsafe.Pointer(&event))))
+	trackCreate(HandleKindEvent, uintptr(eventObject))
+	return eventObject
+}
+
+// trackEventOut accounts the event written by an Enqueue* function, if the caller requested one.
+func trackEventOut(event *Event) {
+	if (event == nil) || (*event == 0) {
+		return
+	}
+	trackCreate(HandleKindEvent, uintptr(*event))
+}
@@ -0,0 +1,133 @@
+package cl30
+
+import (
+	"crypto/sha256"
+	"sync"
+)
+
+// IlModule is an intermediate-language (SPIR-V) module shared between programs and contexts.
+//
+// Passing the same module to CreateProgramWithIl() repeatedly makes the driver parse and
+// validate the same intermediate language every time. An IlModule loads a module once -
+// memory-mapped on platforms that support it, so the pages go to clCreateProgramWithIL without
+// a copy through Go-managed memory - and keeps one program object per context: CreateProgram()
+// returns the existing, retained program when the context was seen before.
+//
+// Modules are deduplicated by content hash: loading a file with identical bytes returns the
+// already-loaded module, including its program cache. An IlModule is safe for concurrent use.
+type IlModule struct {
+	data   []byte
+	mapped bool
+	hash   [sha256.Size]byte
+
+	mutex    sync.Mutex
+	refs     int
+	programs map[Context]Program
+}
+
+var ilModules struct {
+	mutex  sync.Mutex
+	byHash map[[sha256.Size]byte]*IlModule
+}
+
+// LoadIlModule loads an intermediate-language module from a file.
+//
+// If a module with identical content is already loaded, that module is returned instead of
+// mapping the file again. Each successful load must be balanced with a Release().
+func LoadIlModule(path string) (*IlModule, error) {
+	data, mapped, err := mapIlFile(path)
+	if err != nil {
+		return nil, err
+	}
+	hash := sha256.Sum256(data)
+	ilModules.mutex.Lock()
+	defer ilModules.mutex.Unlock()
+	if existing := ilModules.byHash[hash]; existing != nil {
+		if mapped {
+			_ = unmapIlFile(data)
+		}
+		existing.mutex.Lock()
+		existing.refs++
+		existing.mutex.Unlock()
+		return existing, nil
+	}
+	module := &IlModule{
+		data:     data,
+		mapped:   mapped,
+		hash:     hash,
+		refs:     1,
+		programs: make(map[Context]Program),
+	}
+	if ilModules.byHash == nil {
+		ilModules.byHash = make(map[[sha256.Size]byte]*IlModule)
+	}
+	ilModules.byHash[hash] = module
+	return module, nil
+}
+
+// Size returns the size of the module in bytes.
+func (module *IlModule) Size() int {
+	return len(module.data)
+}
+
+// CreateProgram returns a program object for the module in the given context.
+//
+// The first call per context creates the program with CreateProgramWithIl(), passing the loaded
+// module bytes directly; later calls return the same program, retained via RetainProgram().
+// The caller owns the returned reference and releases it with ReleaseProgram() as usual.
+func (module *IlModule) CreateProgram(context Context) (Program, error) {
+	module.mutex.Lock()
+	defer module.mutex.Unlock()
+	if program, ok := module.programs[context]; ok {
+		if err := RetainProgram(program); err != nil {
+			return 0, err
+		}
+		return program, nil
+	}
+	program, err := CreateProgramWithIl(context, module.data)
+	if err != nil {
+		return 0, err
+	}
+	if err := RetainProgram(program); err != nil {
+		_ = ReleaseProgram(program)
+		return 0, err
+	}
+	module.programs[context] = program
+	return program, nil
+}
+
+// Release drops one reference to the module. Once the last reference is gone, the cached
+// program objects are released and the mapped file is unmapped.
+// The first encountered error is returned, the remaining cleanup happens regardless.
+func (module *IlModule) Release() error {
+	ilModules.mutex.Lock()
+	module.mutex.Lock()
+	module.refs--
+	if module.refs > 0 {
+		module.mutex.Unlock()
+		ilModules.mutex.Unlock()
+		return nil
+	}
+	delete(ilModules.byHash, module.hash)
+	programs := module.programs
+	module.programs = nil
+	data := module.data
+	mapped := module.mapped
+	module.data = nil
+	module.mutex.Unlock()
+	ilModules.mutex.Unlock()
+	var firstError error
+	for _, program := range programs {
+		err := ReleaseProgram(program)
+		if (err != nil) && (firstError == nil) {
+			firstError = err
+		}
+	}
+	if mapped {
+		err := unmapIlFile(data)
+		if (err != nil) && (firstError == nil) {
+			firstError = err
+		}
+	}
+	return firstError
+}
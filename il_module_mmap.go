@@ -0,0 +1,35 @@
+//go:build linux || darwin
+
+package cl30
+
+import (
+	"os"
+	"syscall"
+)
+
+// mapIlFile maps the file read-only into memory. The returned bytes live outside the Go heap,
+// so they can be handed to the driver without a copy.
+func mapIlFile(path string) ([]byte, bool, error) {
+	file, err := os.Open(path)
+	if err != nil {
+		return nil, false, err
+	}
+	defer func() { _ = file.Close() }()
+	info, err := file.Stat()
+	if err != nil {
+		return nil, false, err
+	}
+	if info.Size() == 0 {
+		return nil, false, nil
+	}
+	data, err := syscall.Mmap(int(file.Fd()), 0, int(info.Size()), syscall.PROT_READ, syscall.MAP_PRIVATE)
+	if err != nil {
+		return nil, false, err
+	}
+	return data, true, nil
+}
+
+// unmapIlFile releases a mapping created by mapIlFile.
+func unmapIlFile(data []byte) error {
+	return syscall.Munmap(data)
+}
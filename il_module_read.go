@@ -0,0 +1,19 @@
+//go:build !(linux || darwin)
+
+package cl30
+
+import "os"
+
+// mapIlFile reads the file into memory on platforms without memory-mapping support.
+func mapIlFile(path string) ([]byte, bool, error) {
+	data, err := os.ReadFile(path)
+	if err != nil {
+		return nil, false, err
+	}
+	return data, false, nil
+}
+
+// unmapIlFile is a no-op counterpart of the read-based mapIlFile.
+func unmapIlFile(_ []byte) error {
+	return nil
+}
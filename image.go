@@ -102,7 +102,7 @@ func CreateImage(context Context, flags MemFlags, format ImageFormat, desc Image
 	if status != C.CL_SUCCESS {
 		return 0, StatusError(status)
 	}
-	return MemObject(*((*uintptr)(unsafe.Pointer(&mem)))), nil
+	return trackedMemObject(mem), nil
 }
 
 // CreateImageWithProperties creates a 1D image, 1D image buffer, 1D image array, 2D image, 2D image array,
@@ -133,7 +133,7 @@ func CreateImageWithProperties(context Context, flags MemFlags, format ImageForm
 	if status != C.CL_SUCCESS {
 		return 0, StatusError(status)
 	}
-	return MemObject(*((*uintptr)(unsafe.Pointer(&mem)))), nil
+	return trackedMemObject(mem), nil
 }
 
 // SupportedImageFormats returns the list of image formats supported by an OpenCL implementation.
@@ -205,6 +205,7 @@ func EnqueueMapImage(commandQueue CommandQueue,
 	if status != C.CL_SUCCESS {
 		return MappedImage{}, StatusError(status)
 	}
+	trackEventOut(event)
 	return mapped, nil
 }
 
@@ -317,6 +318,7 @@ func EnqueueReadImage(commandQueue CommandQueue, image MemObject, blocking bool,
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
@@ -345,6 +347,7 @@ func EnqueueWriteImage(commandQueue CommandQueue, image MemObject, blocking bool
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
@@ -376,6 +379,7 @@ func EnqueueFillImage(commandQueue CommandQueue, image MemObject, fillColor unsa
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
@@ -401,6 +405,7 @@ func EnqueueCopyImage(commandQueue CommandQueue, srcImage, dstImage MemObject, s
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
@@ -426,6 +431,7 @@ func EnqueueCopyImageToBuffer(commandQueue CommandQueue, srcImage, dstBuffer Mem
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
@@ -451,5 +457,6 @@ func EnqueueCopyBufferToImage(commandQueue CommandQueue, srcBuffer, dstImage Mem
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
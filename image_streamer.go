@@ -0,0 +1,198 @@
+package cl30
+
+import "unsafe"
+
+// ImageStreamerConfig tunes an ImageStreamer; zero values select the defaults.
+type ImageStreamerConfig struct {
+	// TileBytes is the maximum size of one tile, and thereby of one staging buffer.
+	// It defaults to 64 MiB. Transfers of at most this size bypass tiling entirely.
+	TileBytes uintptr
+	// RingDepth is the number of tiles in flight at any time. It defaults to three, which lets
+	// the host-side copy of one tile overlap the device transfer of the previous ones.
+	RingDepth int
+}
+
+// imageStreamerTile is one in-flight tile of a streaming transfer.
+type imageStreamerTile struct {
+	staging *StagingBuffer
+	event   Event
+
+	// Copy-out geometry for read transfers; unused when writing.
+	dst      unsafe.Pointer
+	rows     uintptr
+	rowBytes uintptr
+	dstPitch uintptr
+}
+
+// ImageStreamer transfers images that exceed the staging budget in row-aligned tiles.
+//
+// A single blocking EnqueueReadImage()/EnqueueWriteImage() of a huge image serializes host I/O
+// and device transfer. The streamer splits the region into tiles of whole rows, moves them
+// through a ring of pinned staging buffers (mapped MemAllocHostPtrFlag buffers, as served by
+// StagingPool), and keeps RingDepth tiles in flight: while the device transfers one tile, the
+// host copies the next one into - or a finished one out of - staging memory.
+//
+// Transfers are enqueued without blocking; an out-of-order queue lets the driver overlap them
+// further, but the ring alone already pipelines host and device work on an in-order queue.
+//
+// An ImageStreamer is bound to one command-queue and is not safe for concurrent use.
+type ImageStreamer struct {
+	commandQueue CommandQueue
+	pool         *StagingPool
+	tileBytes    uintptr
+	ringDepth    int
+	inFlight     []imageStreamerTile
+}
+
+// NewImageStreamer creates a streamer moving data through the given command-queue.
+func NewImageStreamer(context Context, commandQueue CommandQueue, config ImageStreamerConfig) *ImageStreamer {
+	tileBytes := config.TileBytes
+	if tileBytes == 0 {
+		tileBytes = 64 * 1024 * 1024
+	}
+	ringDepth := config.RingDepth
+	if ringDepth <= 0 {
+		ringDepth = 3
+	}
+	return &ImageStreamer{
+		commandQueue: commandQueue,
+		pool:         NewStagingPool(context, commandQueue),
+		tileBytes:    tileBytes,
+		ringDepth:    ringDepth,
+	}
+}
+
+// WriteImage transfers host data into the given region of an image, tiled along the rows.
+//
+// The region is {width, height, depth} in pixels, with depth 1 for 2D images. The host data is
+// laid out with the given element size in bytes and optional row and slice pitches; zero pitches
+// mean tightly packed rows and slices. WriteImage returns once all tiles have been transferred.
+func (streamer *ImageStreamer) WriteImage(image MemObject, origin, region [3]uintptr,
+	elementBytes, hostRowPitch, hostSlicePitch uintptr, data unsafe.Pointer) error {
+	return streamer.stream(image, origin, region, elementBytes, hostRowPitch, hostSlicePitch, data, false)
+}
+
+// ReadImage transfers the given region of an image into host memory, tiled along the rows.
+//
+// The parameters mirror WriteImage(). ReadImage returns once all tiles have arrived in the
+// host memory at data.
+func (streamer *ImageStreamer) ReadImage(image MemObject, origin, region [3]uintptr,
+	elementBytes, hostRowPitch, hostSlicePitch uintptr, data unsafe.Pointer) error {
+	return streamer.stream(image, origin, region, elementBytes, hostRowPitch, hostSlicePitch, data, true)
+}
+
+// Release frees the staging buffers of the streamer. In-flight tiles of a failed transfer have
+// been drained before the transfer returned, so Release() can be called at any time in between.
+func (streamer *ImageStreamer) Release() error {
+	return streamer.pool.Close()
+}
+
+// stream runs a tiled transfer in the given direction.
+func (streamer *ImageStreamer) stream(image MemObject, origin, region [3]uintptr,
+	elementBytes, hostRowPitch, hostSlicePitch uintptr, data unsafe.Pointer, read bool) error {
+	width, height, depth := region[0], region[1], region[2]
+	if (width == 0) || (height == 0) || (depth == 0) || (elementBytes == 0) || (data == nil) {
+		return ErrInvalidValue
+	}
+	rowBytes := width * elementBytes
+	if hostRowPitch == 0 {
+		hostRowPitch = rowBytes
+	}
+	if hostSlicePitch == 0 {
+		hostSlicePitch = hostRowPitch * height
+	}
+	rowsPerTile := streamer.tileBytes / rowBytes
+	if rowsPerTile == 0 {
+		rowsPerTile = 1
+	}
+	for z := uintptr(0); z < depth; z++ {
+		for y := uintptr(0); y < height; y += rowsPerTile {
+			rows := height - y
+			if rows > rowsPerTile {
+				rows = rowsPerTile
+			}
+			hostBase := unsafe.Add(data, z*hostSlicePitch+y*hostRowPitch)
+			tileOrigin := [3]uintptr{origin[0], origin[1] + y, origin[2] + z}
+			tileRegion := [3]uintptr{width, rows, 1}
+			err := streamer.enqueueTile(image, tileOrigin, tileRegion, rows, rowBytes, hostRowPitch, hostBase, read)
+			if err != nil {
+				streamer.drainAll()
+				return err
+			}
+		}
+	}
+	return streamer.finish()
+}
+
+// enqueueTile moves one tile into flight, draining the oldest tile first if the ring is full.
+func (streamer *ImageStreamer) enqueueTile(image MemObject, origin, region [3]uintptr,
+	rows, rowBytes, hostPitch uintptr, hostBase unsafe.Pointer, read bool) error {
+	if len(streamer.inFlight) >= streamer.ringDepth {
+		if err := streamer.drainOldest(); err != nil {
+			return err
+		}
+	}
+	staging, err := streamer.pool.Acquire(int(rows * rowBytes))
+	if err != nil {
+		return err
+	}
+	tile := imageStreamerTile{staging: staging, rows: rows, rowBytes: rowBytes}
+	if read {
+		tile.dst = hostBase
+		tile.dstPitch = hostPitch
+		err = EnqueueReadImage(streamer.commandQueue, image, false, origin, region,
+			rowBytes, 0, staging.Ptr(), nil, &tile.event)
+	} else {
+		copyRows(staging.Ptr(), rowBytes, hostBase, hostPitch, rows, rowBytes)
+		err = EnqueueWriteImage(streamer.commandQueue, image, false, origin, region,
+			rowBytes, 0, staging.Ptr(), nil, &tile.event)
+	}
+	if err != nil {
+		streamer.pool.Release(staging)
+		return err
+	}
+	streamer.inFlight = append(streamer.inFlight, tile)
+	return Flush(streamer.commandQueue)
+}
+
+// drainOldest waits for the oldest in-flight tile, copying it out for read transfers, and
+// returns its staging buffer to the pool.
+func (streamer *ImageStreamer) drainOldest() error {
+	tile := streamer.inFlight[0]
+	streamer.inFlight = streamer.inFlight[:copy(streamer.inFlight, streamer.inFlight[1:])]
+	err := AwaitEvents([]Event{tile.event})
+	_ = ReleaseEvent(tile.event)
+	if (err == nil) && (tile.dst != nil) {
+		copyRows(tile.dst, tile.dstPitch, tile.staging.Ptr(), tile.rowBytes, tile.rows, tile.rowBytes)
+	}
+	streamer.pool.Release(tile.staging)
+	return err
+}
+
+// finish drains all in-flight tiles, returning the first encountered error.
+func (streamer *ImageStreamer) finish() error {
+	var firstError error
+	for len(streamer.inFlight) > 0 {
+		err := streamer.drainOldest()
+		if (err != nil) && (firstError == nil) {
+			firstError = err
+		}
+	}
+	return firstError
+}
+
+// drainAll drains all in-flight tiles, ignoring their results; used on the error path.
+func (streamer *ImageStreamer) drainAll() {
+	for len(streamer.inFlight) > 0 {
+		_ = streamer.drainOldest()
+	}
+}
+
+// copyRows copies a block of rows between two host memory areas with differing row pitches.
+func copyRows(dst unsafe.Pointer, dstPitch uintptr, src unsafe.Pointer, srcPitch uintptr, rows, rowBytes uintptr) {
+	for row := uintptr(0); row < rows; row++ {
+		dstRow := unsafe.Slice((*byte)(unsafe.Add(dst, row*dstPitch)), rowBytes)
+		srcRow := unsafe.Slice((*byte)(unsafe.Add(src, row*srcPitch)), rowBytes)
+		copy(dstRow, srcRow)
+	}
+}
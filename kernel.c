@@ -20,3 +20,27 @@ cl_int cl30EnqueueNativeKernel(cl_command_queue commandQueue,
         waitListCount, waitList,
         event);
 }
+
+cl_int cl30SetKernelArgs(cl_kernel kernel, cl_uint count, cl_uint const *indices, size_t const *sizes,
+    uintptr_t const *values, cl_uint const *svmFlags, cl_uint *failureIndex)
+{
+    cl_uint i;
+    for (i = 0; i < count; i++)
+    {
+        cl_int status;
+        if (svmFlags[i] != 0)
+        {
+            status = clSetKernelArgSVMPointer(kernel, indices[i], (void const *)(values[i]));
+        }
+        else
+        {
+            status = clSetKernelArg(kernel, indices[i], sizes[i], (void const *)(values[i]));
+        }
+        if (status != CL_SUCCESS)
+        {
+            *failureIndex = i;
+            return status;
+        }
+    }
+    return CL_SUCCESS;
+}
@@ -36,7 +36,7 @@ func CreateKernel(program Program, name string) (Kernel, error) {
 	if status != C.CL_SUCCESS {
 		return 0, StatusError(status)
 	}
-	return Kernel(*((*uintptr)(unsafe.Pointer(&kernel)))), nil
+	return trackedKernel(kernel), nil
 }
 
 // CreateKernelsInProgram creates kernel objects for all kernel functions in a program object.
@@ -76,7 +76,13 @@ func CreateKernelsInProgram(program Program) ([]Kernel, error) {
 	if status != C.CL_SUCCESS {
 		return nil, StatusError(status)
 	}
-	return kernels[:int(returnedCount)], nil
+	created := kernels[:int(returnedCount)]
+	if handleTrackingEnabled() {
+		for _, kernel := range created {
+			trackCreate(HandleKindKernel, uintptr(kernel))
+		}
+	}
+	return created, nil
 }
 
 // CloneKernel makes a shallow copy of the kernel object.
@@ -110,7 +116,7 @@ func CloneKernel(kernel Kernel) (Kernel, error) {
 	if status != C.CL_SUCCESS {
 		return 0, StatusError(status)
 	}
-	return Kernel(*((*uintptr)(unsafe.Pointer(&kernelCopy)))), nil
+	return trackedKernel(kernelCopy), nil
 }
 
 // RetainKernel increments the kernel reference count.
@@ -121,6 +127,7 @@ func RetainKernel(kernel Kernel) error {
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackCreate(HandleKindKernel, uintptr(kernel))
 	return nil
 }
 
@@ -135,6 +142,7 @@ func ReleaseKernel(kernel Kernel) error {
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackRelease(HandleKindKernel, uintptr(kernel))
 	return nil
 }
 
@@ -269,9 +277,7 @@ func KernelInfo(kernel Kernel, paramName KernelInfoName, paramSize uintptr, para
 // This function does not verify the queried information is indeed of type string. It assumes the information is
 // a NUL terminated raw string and will extract the bytes as characters before that.
 func KernelInfoString(kernel Kernel, paramName KernelInfoName) (string, error) {
-	return queryString(func(paramSize uintptr, paramValue unsafe.Pointer) (uintptr, error) {
-		return KernelInfo(kernel, paramName, paramSize, paramValue)
-	})
+	return queryStringShim(queryTargetKernel, unsafe.Pointer(kernel.handle()), nil, uint32(paramName))
 }
 
 // KernelWorkGroupInfoName identifies properties of a kernel work group, which can be queried with KernelWorkGroupInfo().
@@ -595,6 +601,79 @@ func EnqueueNDRangeKernel(commandQueue CommandQueue, kernel Kernel, workDimensio
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
+	return nil
+}
+
+// ndRangeMaxWorkDimensions is the number of work dimensions an NDRange can hold.
+const ndRangeMaxWorkDimensions = 3
+
+// NDRange is a reusable description of the execution range of a kernel launch.
+//
+// EnqueueNDRangeKernel() transposes its workDimensions argument into three freshly allocated slices on
+// every call. For high-frequency launches, these allocations become a measurable source of garbage
+// collector pressure. An NDRange keeps the transposed form in fixed arrays, so the steady-state launch
+// path of EnqueueNDRange() performs no heap allocations.
+//
+// Up to three work dimensions are supported.
+type NDRange struct {
+	dimensions        uint32
+	globalWorkOffsets [ndRangeMaxWorkDimensions]uintptr
+	globalWorkSizes   [ndRangeMaxWorkDimensions]uintptr
+	localWorkSizes    [ndRangeMaxWorkDimensions]uintptr
+}
+
+// SetWorkDimensions stores the given work dimensions in their transposed form.
+// The previously stored dimensions are replaced.
+//
+// Up to three work dimensions are supported; ErrInvalidWorkDimension is returned for other counts.
+func (ndRange *NDRange) SetWorkDimensions(workDimensions []WorkDimension) error {
+	if (len(workDimensions) == 0) || (len(workDimensions) > ndRangeMaxWorkDimensions) {
+		return ErrInvalidWorkDimension
+	}
+	ndRange.dimensions = uint32(len(workDimensions))
+	for i, dimension := range workDimensions {
+		ndRange.globalWorkOffsets[i] = dimension.GlobalOffset
+		ndRange.globalWorkSizes[i] = dimension.GlobalSize
+		ndRange.localWorkSizes[i] = dimension.LocalSize
+	}
+	return nil
+}
+
+// WorkDimensionCount returns the number of currently stored work dimensions.
+func (ndRange *NDRange) WorkDimensionCount() int {
+	return int(ndRange.dimensions)
+}
+
+// EnqueueNDRange enqueues a command to execute a kernel on a device, based on a prepared NDRange.
+//
+// It is the allocation-free equivalent of EnqueueNDRangeKernel(): the range description is reused
+// as-is, and no intermediate slices are created. Prepare the range once with
+// NDRange.SetWorkDimensions() and reuse it for subsequent launches.
+//
+// See also: https://registry.khronos.org/OpenCL/sdk/3.0/docs/man/html/clEnqueueNDRangeKernel.html
+func EnqueueNDRange(commandQueue CommandQueue, kernel Kernel, ndRange *NDRange, waitList []Event, event *Event) error {
+	if (ndRange == nil) || (ndRange.dimensions == 0) {
+		return ErrInvalidWorkDimension
+	}
+	var rawWaitList unsafe.Pointer
+	if len(waitList) > 0 {
+		rawWaitList = unsafe.Pointer(&waitList[0])
+	}
+	status := C.clEnqueueNDRangeKernel(
+		commandQueue.handle(),
+		kernel.handle(),
+		C.cl_uint(ndRange.dimensions),
+		(*C.size_t)(unsafe.Pointer(&ndRange.globalWorkOffsets[0])),
+		(*C.size_t)(unsafe.Pointer(&ndRange.globalWorkSizes[0])),
+		(*C.size_t)(unsafe.Pointer(&ndRange.localWorkSizes[0])),
+		C.cl_uint(len(waitList)),
+		(*C.cl_event)(rawWaitList),
+		(*C.cl_event)(unsafe.Pointer(event)))
+	if status != C.CL_SUCCESS {
+		return StatusError(status)
+	}
+	trackEventOut(event)
 	return nil
 }
 
@@ -650,6 +729,7 @@ func EnqueueNativeKernel(commandQueue CommandQueue, callback func([]unsafe.Point
 		callbackUserData.Delete()
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
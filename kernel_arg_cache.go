@@ -0,0 +1,102 @@
+package cl30
+
+import (
+	"bytes"
+	"unsafe"
+)
+
+// kernelArgShadow mirrors the last value set for one kernel argument index.
+type kernelArgShadow struct {
+	valid   bool
+	svm     bool
+	ptr     uintptr
+	size    uintptr
+	hasData bool
+	data    []byte
+}
+
+// KernelArgCache skips redundant argument updates for a kernel.
+//
+// Iterative workloads often re-set every kernel argument before each launch, even though most of
+// them did not change. Each SetKernelArg() is a cgo call, so the redundant updates add up at high
+// launch rates. The cache keeps a host-side shadow copy of the last value set per argument index
+// and only forwards updates whose value actually differs.
+//
+// The cache assumes it is the only writer of the kernel arguments; updates applied directly via
+// SetKernelArg() are not observed. Call Invalidate() to resynchronize in that case.
+//
+// A KernelArgCache is bound to one kernel object and is not safe for concurrent use.
+type KernelArgCache struct {
+	kernel Kernel
+	args   []kernelArgShadow
+}
+
+// NewKernelArgCache returns a cache for the arguments of the given kernel.
+func NewKernelArgCache(kernel Kernel) *KernelArgCache {
+	return &KernelArgCache{kernel: kernel}
+}
+
+// Kernel returns the kernel object the cache is bound to.
+func (cache *KernelArgCache) Kernel() Kernel {
+	return cache.kernel
+}
+
+// Invalidate drops all shadow copies, so the next update of every argument is forwarded again.
+func (cache *KernelArgCache) Invalidate() {
+	for i := range cache.args {
+		cache.args[i].valid = false
+	}
+}
+
+// SetArg sets the argument value for a specific argument of the kernel, unless the identical
+// value is already set. It mirrors SetKernelArg() otherwise.
+func (cache *KernelArgCache) SetArg(index uint32, size uintptr, value unsafe.Pointer) error {
+	shadow := cache.shadowFor(index)
+	var view []byte
+	if value != nil {
+		view = unsafe.Slice((*byte)(value), size)
+	}
+	if shadow.valid && !shadow.svm && (shadow.size == size) &&
+		(shadow.hasData == (value != nil)) && bytes.Equal(shadow.data, view) {
+		return nil
+	}
+	if err := SetKernelArg(cache.kernel, index, size, value); err != nil {
+		shadow.valid = false
+		return err
+	}
+	shadow.valid = true
+	shadow.svm = false
+	shadow.ptr = 0
+	shadow.size = size
+	shadow.hasData = value != nil
+	shadow.data = append(shadow.data[:0], view...)
+	return nil
+}
+
+// SetArgSvmPointer sets an SVM pointer as the argument value for a specific argument of the
+// kernel, unless the identical pointer is already set. It mirrors SetKernelArgSvmPointer() otherwise.
+func (cache *KernelArgCache) SetArgSvmPointer(index uint32, value unsafe.Pointer) error {
+	shadow := cache.shadowFor(index)
+	if shadow.valid && shadow.svm && (shadow.ptr == uintptr(value)) {
+		return nil
+	}
+	if err := SetKernelArgSvmPointer(cache.kernel, index, value); err != nil {
+		shadow.valid = false
+		return err
+	}
+	shadow.valid = true
+	shadow.svm = true
+	shadow.ptr = uintptr(value)
+	shadow.size = 0
+	shadow.hasData = false
+	shadow.data = shadow.data[:0]
+	return nil
+}
+
+// shadowFor returns the shadow entry for the given index, growing the storage if necessary.
+func (cache *KernelArgCache) shadowFor(index uint32) *kernelArgShadow {
+	for uint32(len(cache.args)) <= index {
+		cache.args = append(cache.args, kernelArgShadow{})
+	}
+	return &cache.args[index]
+}
@@ -0,0 +1,78 @@
+package cl30
+
+// #include "api.h"
+// extern cl_int cl30SetKernelArgs(cl_kernel kernel, cl_uint count, cl_uint const *indices, size_t const *sizes,
+//     uintptr_t const *values, cl_uint const *svmFlags, cl_uint *failureIndex);
+import "C"
+import "unsafe"
+
+// KernelArgBatch records kernel argument bindings and applies them with a single cgo crossing.
+//
+// Binding every argument of a kernel through individual SetKernelArg() calls costs one crossing
+// per argument, which adds up at high reconfiguration rates. A batch records the bindings on the
+// host and forwards them through one C loop over clSetKernelArg()/clSetKernelArgSVMPointer().
+//
+// While KernelArgCache skips redundant updates on one kernel, a batch is for the initial, full
+// binding of a kernel's arguments; the two can be combined by batching only on first use.
+//
+// A batch can be reused across kernels and reconfigurations via Reset(), keeping its backing
+// arrays. It is not safe for concurrent use.
+type KernelArgBatch struct {
+	indices  []C.cl_uint
+	sizes    []C.size_t
+	values   []C.uintptr_t
+	svmFlags []C.cl_uint
+}
+
+// Len returns the number of recorded bindings.
+func (batch *KernelArgBatch) Len() int {
+	return len(batch.indices)
+}
+
+// Reset drops all recorded bindings, keeping the backing arrays for reuse.
+func (batch *KernelArgBatch) Reset() {
+	batch.indices = batch.indices[:0]
+	batch.sizes = batch.sizes[:0]
+	batch.values = batch.values[:0]
+	batch.svmFlags = batch.svmFlags[:0]
+}
+
+// Record adds one binding, equivalent to SetKernelArg() with the same parameters.
+// The memory value points to must remain valid and unmodified until Bind() returns.
+func (batch *KernelArgBatch) Record(index uint32, size uintptr, value unsafe.Pointer) {
+	batch.indices = append(batch.indices, C.cl_uint(index))
+	batch.sizes = append(batch.sizes, C.size_t(size))
+	batch.values = append(batch.values, C.uintptr_t(uintptr(value)))
+	batch.svmFlags = append(batch.svmFlags, 0)
+}
+
+// RecordSvmPointer adds one binding, equivalent to SetKernelArgSVMPointer() with the same
+// parameters. The value must be the base address, or an offset within, an SvmAlloc() allocation.
+func (batch *KernelArgBatch) RecordSvmPointer(index uint32, value unsafe.Pointer) {
+	batch.indices = append(batch.indices, C.cl_uint(index))
+	batch.sizes = append(batch.sizes, 0)
+	batch.values = append(batch.values, C.uintptr_t(uintptr(value)))
+	batch.svmFlags = append(batch.svmFlags, 1)
+}
+
+// Bind applies all recorded bindings to the kernel, in recording order, and returns the number
+// of bindings that were applied. Binding stops at the first failure, so on error the returned
+// count identifies the recorded binding that failed.
+func (batch *KernelArgBatch) Bind(kernel Kernel) (int, error) {
+	if len(batch.indices) == 0 {
+		return 0, nil
+	}
+	var failureIndex C.cl_uint
+	status := C.cl30SetKernelArgs(
+		kernel.handle(),
+		C.cl_uint(len(batch.indices)),
+		&batch.indices[0],
+		&batch.sizes[0],
+		&batch.values[0],
+		&batch.svmFlags[0],
+		&failureIndex)
+	if status != C.CL_SUCCESS {
+		return int(failureIndex), StatusError(status)
+	}
+	return len(batch.indices), nil
+}
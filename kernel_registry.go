@@ -0,0 +1,133 @@
+package cl30
+
+import (
+	"sync"
+)
+
+// kernelRegistryEntry holds the prototype kernel of one function name, plus a pool of idle clones.
+type kernelRegistryEntry struct {
+	prototype Kernel
+
+	mutex  sync.Mutex
+	clones []Kernel
+}
+
+// KernelRegistry resolves the kernels of one program by function name without driver traffic.
+//
+// CreateKernel() converts the name to a C string and performs a driver call on every invocation.
+// A registry instead pre-creates all kernels of a program once, through CreateKernelsInProgram(),
+// and indexes them by their KernelFunctionNameInfo. The index is immutable after creation, so a
+// lookup is a plain map read and safe for concurrent use without locking.
+//
+// Kernel objects carry argument state, which makes sharing one object across goroutines unsafe.
+// Acquire() therefore hands out CloneKernel() copies of the prototype; Recycle() returns a copy
+// to a per-name pool for reuse.
+type KernelRegistry struct {
+	entries map[string]*kernelRegistryEntry
+}
+
+// NewKernelRegistry creates all kernels of the given program and indexes them by function name.
+//
+// The program must have been built for at least one device before kernels can be created from it.
+func NewKernelRegistry(program Program) (*KernelRegistry, error) {
+	kernels, err := CreateKernelsInProgram(program)
+	if err != nil {
+		return nil, err
+	}
+	entries := make(map[string]*kernelRegistryEntry, len(kernels))
+	for _, kernel := range kernels {
+		name, err := KernelInfoString(kernel, KernelFunctionNameInfo)
+		if err != nil {
+			for _, created := range kernels {
+				_ = ReleaseKernel(created)
+			}
+			return nil, err
+		}
+		entries[name] = &kernelRegistryEntry{prototype: kernel}
+	}
+	return &KernelRegistry{entries: entries}, nil
+}
+
+// Names returns the function names of all kernels in the registry, in no particular order.
+func (registry *KernelRegistry) Names() []string {
+	names := make([]string, 0, len(registry.entries))
+	for name := range registry.entries {
+		names = append(names, name)
+	}
+	return names
+}
+
+// Kernel returns the prototype kernel of the given function name.
+//
+// The prototype is shared between all callers and remains owned by the registry; use it only for
+// queries such as KernelWorkGroupInfo(), not for argument binding. ErrInvalidKernelName is
+// returned if the program has no kernel of that name.
+func (registry *KernelRegistry) Kernel(name string) (Kernel, error) {
+	entry, ok := registry.entries[name]
+	if !ok {
+		return 0, ErrInvalidKernelName
+	}
+	return entry.prototype, nil
+}
+
+// Acquire returns a kernel of the given function name for exclusive use by the caller, suitable
+// for concurrent argument binding. The kernel comes from the per-name pool if one is idle, and is
+// a fresh CloneKernel() copy of the prototype otherwise.
+//
+// Pass the kernel back via Recycle() for reuse, or dispose of it with ReleaseKernel().
+// ErrInvalidKernelName is returned if the program has no kernel of that name.
+func (registry *KernelRegistry) Acquire(name string) (Kernel, error) {
+	entry, ok := registry.entries[name]
+	if !ok {
+		return 0, ErrInvalidKernelName
+	}
+	entry.mutex.Lock()
+	if count := len(entry.clones); count > 0 {
+		kernel := entry.clones[count-1]
+		entry.clones = entry.clones[:count-1]
+		entry.mutex.Unlock()
+		return kernel, nil
+	}
+	entry.mutex.Unlock()
+	return CloneKernel(entry.prototype)
+}
+
+// Recycle returns a kernel previously handed out by Acquire() for the given function name to the
+// pool. Any argument state set by the caller remains on the kernel and will be seen - and can be
+// overwritten - by the next Acquire() of the same name.
+//
+// ErrInvalidKernelName is returned if the program has no kernel of that name; the kernel is not
+// released in that case.
+func (registry *KernelRegistry) Recycle(name string, kernel Kernel) error {
+	entry, ok := registry.entries[name]
+	if !ok {
+		return ErrInvalidKernelName
+	}
+	entry.mutex.Lock()
+	defer entry.mutex.Unlock()
+	entry.clones = append(entry.clones, kernel)
+	return nil
+}
+
+// Release releases all prototype kernels and pooled clones of the registry.
+// Kernels handed out by Acquire() and not yet recycled are unaffected.
+// The first encountered error is returned, the remaining kernels are released regardless.
+func (registry *KernelRegistry) Release() error {
+	var firstError error
+	for _, entry := range registry.entries {
+		entry.mutex.Lock()
+		for _, kernel := range entry.clones {
+			err := ReleaseKernel(kernel)
+			if (err != nil) && (firstError == nil) {
+				firstError = err
+			}
+		}
+		entry.clones = nil
+		entry.mutex.Unlock()
+		err := ReleaseKernel(entry.prototype)
+		if (err != nil) && (firstError == nil) {
+			firstError = err
+		}
+	}
+	return firstError
+}
@@ -0,0 +1,35 @@
+package cl30
+
+import "unsafe"
+
+// MapSlice enqueues a command to map a region of a buffer object into the host address space and
+// returns the mapped region as a typed slice.
+//
+// The returned slice is backed directly by the mapped memory - no copy is involved. The offset is
+// given in bytes, the count in elements of T; the mapped region spans count times the size of T.
+//
+// When mapping non-blocking, the slice memory must not be accessed before the returned event has
+// completed. The view stays valid until it is unmapped with UnmapSlice().
+//
+// See also: https://registry.khronos.org/OpenCL/sdk/3.0/docs/man/html/clEnqueueMapBuffer.html
+func MapSlice[T any](commandQueue CommandQueue, mem MemObject, blocking bool, flags MapFlags, offset uintptr, count int,
+	waitList []Event, event *Event) ([]T, error) {
+	var element T
+	ptr, err := EnqueueMapBuffer(commandQueue, mem, blocking, flags, offset, uintptr(count)*unsafe.Sizeof(element), waitList, event)
+	if err != nil {
+		return nil, err
+	}
+	return unsafe.Slice((*T)(ptr), count), nil
+}
+
+// UnmapSlice enqueues a command to unmap a view previously returned by MapSlice().
+// The view must not be accessed afterwards.
+//
+// See also: https://registry.khronos.org/OpenCL/sdk/3.0/docs/man/html/clEnqueueUnmapMemObject.html
+func UnmapSlice[T any](commandQueue CommandQueue, mem MemObject, view []T, waitList []Event, event *Event) error {
+	var ptr unsafe.Pointer
+	if len(view) > 0 {
+		ptr = unsafe.Pointer(&view[0])
+	}
+	return EnqueueUnmapMemObject(commandQueue, mem, ptr, waitList, event)
+}
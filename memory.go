@@ -34,6 +34,7 @@ func RetainMemObject(mem MemObject) error {
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackCreate(HandleKindMemObject, uintptr(mem))
 	return nil
 }
 
@@ -49,6 +50,7 @@ func ReleaseMemObject(mem MemObject) error {
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackRelease(HandleKindMemObject, uintptr(mem))
 	return nil
 }
 
@@ -247,6 +249,7 @@ func EnqueueUnmapMemObject(commandQueue CommandQueue, mem MemObject, mappedPtr u
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
@@ -299,5 +302,6 @@ func EnqueueMigrateMemObjects(commandQueue CommandQueue, memObjects []MemObject,
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
@@ -0,0 +1,224 @@
+package cl30
+
+// #include "api.h"
+// extern cl_int cl30EnqueueNativeKernel(cl_command_queue commandQueue,
+//    void *args, size_t argsSize,
+//    cl_uint numMemObjects, cl_mem *memList, void const *argsMemLoc,
+//    cl_uint waitListCount, cl_event const *waitList,
+//    cl_event *event);
+// extern cl_int cl30EnqueueSVMFree(cl_command_queue commandQueue,
+//    cl_uint svmPointerCount, void *svmPointers,
+//    uintptr_t *userData,
+//    cl_uint waitListCount, cl_event const *waitList,
+//    cl_event *event);
+import "C"
+import (
+	"sync"
+	"unsafe"
+)
+
+// nativeKernelOp carries the state of one in-flight native-kernel enqueue.
+// The trampoline closure is created once and lives as long as the op recycles.
+type nativeKernelOp struct {
+	arena      *OperationArena
+	callback   func([]unsafe.Pointer)
+	memPtrs    []unsafe.Pointer
+	trampoline func(unsafe.Pointer)
+}
+
+// svmFreeOp carries the state of one in-flight SVM-free enqueue with a callback.
+type svmFreeOp struct {
+	arena    *OperationArena
+	callback func(CommandQueue, []unsafe.Pointer)
+	wrapper  func(CommandQueue, []unsafe.Pointer)
+}
+
+// OperationArena recycles the per-call state of callback-carrying enqueues.
+//
+// EnqueueNativeKernel() allocates a closure, an argument block, and two index slices on every
+// call, and the callback path of EnqueueSvmFree() allocates similarly. At thousands of native
+// kernels per second - for example CPU-side pipeline stages interleaved with device work -
+// these paths dominate the garbage produced by submission code. The arena keeps the argument
+// blocks as reusable scratch (the driver copies them during the enqueue call) and recycles the
+// per-operation closures and pointer slices once the operation's callback has completed, so
+// repeated enqueues with the same mem-object count allocate nothing beyond the callback
+// registration itself.
+//
+// Completion callbacks return their operation to the arena from driver threads, which is
+// synchronized; the enqueue methods themselves share the scratch blocks and are not safe for
+// concurrent use. Use one arena per queue or per submitting worker.
+type OperationArena struct {
+	argScratch     []uintptr
+	memLocScratch  []uintptr
+	addressScratch []uintptr
+
+	mutex          sync.Mutex
+	nativeFreeList []*nativeKernelOp
+	svmFreeList    []*svmFreeOp
+}
+
+// NewOperationArena creates an empty arena; slabs grow on demand and are retained for reuse.
+func NewOperationArena() *OperationArena {
+	return &OperationArena{}
+}
+
+// EnqueueNativeKernel enqueues a native Go function, like the package-level EnqueueNativeKernel(),
+// with the per-call state drawn from the arena.
+func (arena *OperationArena) EnqueueNativeKernel(commandQueue CommandQueue, callback func([]unsafe.Pointer),
+	memObjects []MemObject, waitList []Event, event *Event) error {
+	count := len(memObjects)
+	op := arena.acquireNativeOp(count)
+	op.callback = callback
+	callbackUserData, err := userDataFor(op.trampoline)
+	if err != nil {
+		arena.releaseNativeOp(op)
+		return err
+	}
+	arena.argScratch = growUintptrSlice(arena.argScratch, count+1)
+	arena.memLocScratch = growUintptrSlice(arena.memLocScratch, count)
+	rawArgs := arena.argScratch
+	rawArgs[0] = uintptr(unsafe.Pointer(callbackUserData.ptr))
+	var rawWaitList unsafe.Pointer
+	if len(waitList) > 0 {
+		rawWaitList = unsafe.Pointer(&waitList[0])
+	}
+	var rawMemObjectsPtr unsafe.Pointer
+	var rawArgsMemLocsPtr unsafe.Pointer
+	if count > 0 {
+		rawMemObjectsPtr = unsafe.Pointer(&memObjects[0])
+		for i := 0; i < count; i++ {
+			arena.memLocScratch[i] = uintptr(unsafe.Pointer(&rawArgs[1+i]))
+		}
+		rawArgsMemLocsPtr = unsafe.Pointer(&arena.memLocScratch[0])
+	}
+	status := C.cl30EnqueueNativeKernel(
+		commandQueue.handle(),
+		unsafe.Pointer(&rawArgs[0]),
+		C.size_t(uintptr(len(rawArgs))*unsafe.Sizeof(uintptr(0))),
+		C.cl_uint(count),
+		(*C.cl_mem)(rawMemObjectsPtr),
+		rawArgsMemLocsPtr,
+		C.cl_uint(len(waitList)),
+		(*C.cl_event)(rawWaitList),
+		(*C.cl_event)(unsafe.Pointer(event)))
+	if status != C.CL_SUCCESS {
+		callbackUserData.Delete()
+		arena.releaseNativeOp(op)
+		return StatusError(status)
+	}
+	trackEventOut(event)
+	return nil
+}
+
+// EnqueueSvmFree enqueues an SVM free, like the package-level EnqueueSvmFree(), with the
+// per-call state drawn from the arena.
+func (arena *OperationArena) EnqueueSvmFree(commandQueue CommandQueue, ptrs []unsafe.Pointer,
+	callback func(CommandQueue, []unsafe.Pointer), waitList []Event, event *Event) error {
+	var callbackUserData userData
+	var op *svmFreeOp
+	if callback != nil {
+		op = arena.acquireSvmFreeOp()
+		op.callback = callback
+		var err error
+		callbackUserData, err = userDataFor(op.wrapper)
+		if err != nil {
+			arena.releaseSvmFreeOp(op)
+			return err
+		}
+	}
+	arena.addressScratch = growUintptrSlice(arena.addressScratch, len(ptrs))
+	for i, ptr := range ptrs {
+		arena.addressScratch[i] = uintptr(ptr)
+	}
+	var rawWaitList unsafe.Pointer
+	if len(waitList) > 0 {
+		rawWaitList = unsafe.Pointer(&waitList[0])
+	}
+	status := C.cl30EnqueueSVMFree(
+		commandQueue.handle(),
+		C.cl_uint(len(ptrs)),
+		unsafe.Pointer(&arena.addressScratch[0]),
+		callbackUserData.ptr,
+		C.cl_uint(len(waitList)),
+		(*C.cl_event)(rawWaitList),
+		(*C.cl_event)(unsafe.Pointer(event)))
+	if status != C.CL_SUCCESS {
+		callbackUserData.Delete()
+		if op != nil {
+			arena.releaseSvmFreeOp(op)
+		}
+		return StatusError(status)
+	}
+	trackEventOut(event)
+	return nil
+}
+
+// acquireNativeOp returns a recycled operation, or a fresh one with its trampoline closure.
+func (arena *OperationArena) acquireNativeOp(memObjectCount int) *nativeKernelOp {
+	arena.mutex.Lock()
+	var op *nativeKernelOp
+	if count := len(arena.nativeFreeList); count > 0 {
+		op = arena.nativeFreeList[count-1]
+		arena.nativeFreeList = arena.nativeFreeList[:count-1]
+	}
+	arena.mutex.Unlock()
+	if op == nil {
+		op = &nativeKernelOp{arena: arena}
+		op.trampoline = func(argBasePtr unsafe.Pointer) {
+			argMovePtr := argBasePtr
+			for i := range op.memPtrs {
+				op.memPtrs[i] = unsafe.Pointer(*(**uintptr)(argMovePtr))
+				argMovePtr = unsafe.Add(argMovePtr, unsafe.Sizeof(uintptr(0)))
+			}
+			op.callback(op.memPtrs)
+			op.callback = nil
+			op.arena.releaseNativeOp(op)
+		}
+	}
+	if cap(op.memPtrs) < memObjectCount {
+		op.memPtrs = make([]unsafe.Pointer, memObjectCount)
+	} else {
+		op.memPtrs = op.memPtrs[:memObjectCount]
+	}
+	return op
+}
+
+// releaseNativeOp returns an operation to the free list.
+func (arena *OperationArena) releaseNativeOp(op *nativeKernelOp) {
+	arena.mutex.Lock()
+	defer arena.mutex.Unlock()
+	arena.nativeFreeList = append(arena.nativeFreeList, op)
+}
+
+// acquireSvmFreeOp returns a recycled operation, or a fresh one with its wrapper closure.
+func (arena *OperationArena) acquireSvmFreeOp() *svmFreeOp {
+	arena.mutex.Lock()
+	defer arena.mutex.Unlock()
+	if count := len(arena.svmFreeList); count > 0 {
+		op := arena.svmFreeList[count-1]
+		arena.svmFreeList = arena.svmFreeList[:count-1]
+		return op
+	}
+	op := &svmFreeOp{arena: arena}
+	op.wrapper = func(commandQueue CommandQueue, freedPtrs []unsafe.Pointer) {
+		op.callback(commandQueue, freedPtrs)
+		op.callback = nil
+		op.arena.releaseSvmFreeOp(op)
+	}
+	return op
+}
+
+// releaseSvmFreeOp returns an operation to the free list.
+func (arena *OperationArena) releaseSvmFreeOp(op *svmFreeOp) {
+	arena.mutex.Lock()
+	defer arena.mutex.Unlock()
+	arena.svmFreeList = append(arena.svmFreeList, op)
+}
+
+// growUintptrSlice resizes the scratch slice to the given length, reusing its backing array.
+func growUintptrSlice(scratch []uintptr, length int) []uintptr {
+	if cap(scratch) < length {
+		return make([]uintptr, length)
+	}
+	return scratch[:length]
+}
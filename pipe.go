@@ -35,7 +35,7 @@ func CreatePipe(context Context, flags MemFlags, packetSize, maxPackets uint32,
 	if status != C.CL_SUCCESS {
 		return 0, StatusError(status)
 	}
-	return MemObject(*((*uintptr)(unsafe.Pointer(&pipe)))), nil
+	return trackedMemObject(pipe), nil
 }
 
 // PipeInfoName identifies properties of a pipe, which can be queried with PipeInfo().
@@ -0,0 +1,197 @@
+package cl30
+
+// #include "api.h"
+import "C"
+import "unsafe"
+
+// PipelineChunk describes one chunk of a streaming pipeline run, as passed to the launch function.
+type PipelineChunk struct {
+	// Index is the zero-based number of the chunk.
+	Index int
+	// Size is the size of the chunk in bytes.
+	Size uintptr
+	// Input is the device buffer holding the uploaded chunk data.
+	Input MemObject
+	// Output is the device buffer the kernel shall write its result to.
+	Output MemObject
+}
+
+// PipelineConfig describes a streaming pipeline run; see RunPipeline().
+type PipelineConfig struct {
+	// Context is used to allocate the rotating buffer sets.
+	Context Context
+	// ChunkBytes is the capacity, in bytes, of each input and output buffer.
+	ChunkBytes uintptr
+	// ChunkCount is the total number of chunks to process.
+	ChunkCount int
+	// SetCount is the number of rotating buffer sets. It defaults to three, which allows upload,
+	// compute, and download of neighbouring chunks to overlap. Two sets halve the memory at the
+	// cost of overlapping only two of the stages.
+	SetCount int
+	// Source provides the host data of a chunk for upload. The returned memory must remain valid
+	// until Sink is called for the same chunk index. The size must not exceed ChunkBytes.
+	Source func(chunkIndex int) (unsafe.Pointer, uintptr, error)
+	// Launch enqueues the kernel for one chunk. The provided wait list covers the upload of the
+	// chunk and must be passed on; the resulting event must be stored in event.
+	Launch func(commandQueue CommandQueue, chunk PipelineChunk, waitList []Event, event *Event) error
+	// Sink receives the downloaded result of a chunk. The memory is owned by the pipeline and
+	// only valid for the duration of the call. Results arrive in chunk order.
+	Sink func(chunkIndex int, data unsafe.Pointer, size uintptr) error
+}
+
+// pipelineSet is one rotating buffer set of a pipeline run.
+type pipelineSet struct {
+	input      MemObject
+	output     MemObject
+	hostOut    unsafe.Pointer
+	readEvent  Event
+	chunkIndex int
+	chunkSize  uintptr
+	active     bool
+}
+
+// RunPipeline processes a chunked dataset with overlapped upload, compute, and download.
+//
+// Datasets beyond device memory need to be streamed in chunks, and achieving transfer/compute
+// overlap requires a carefully chained event graph. RunPipeline() owns that graph: it allocates
+// SetCount rotating buffer sets and, for every chunk, chains upload, kernel, and download through
+// events. While one chunk executes, the next one uploads and the previous result downloads.
+//
+// The command-queue should be created with QueueOutOfOrderExecModeEnable for full overlap;
+// the event chaining keeps per-chunk ordering correct either way. The output of a chunk is
+// assumed to have the same size as its input.
+//
+// The run aborts on the first error. Assume device buffer contents to be undefined afterwards.
+func RunPipeline(commandQueue CommandQueue, config PipelineConfig) error {
+	if (config.Context == 0) || (config.ChunkBytes == 0) ||
+		(config.Source == nil) || (config.Launch == nil) || (config.Sink == nil) {
+		return ErrInvalidValue
+	}
+	setCount := config.SetCount
+	if setCount <= 0 {
+		setCount = 3
+	}
+	if setCount > config.ChunkCount {
+		setCount = config.ChunkCount
+	}
+	if setCount == 0 {
+		return nil
+	}
+	sets := make([]*pipelineSet, 0, setCount)
+	defer func() {
+		for _, set := range sets {
+			set.release()
+		}
+	}()
+	for i := 0; i < setCount; i++ {
+		set, err := newPipelineSet(config.Context, config.ChunkBytes)
+		if err != nil {
+			return err
+		}
+		sets = append(sets, set)
+	}
+	for chunkIndex := 0; chunkIndex < config.ChunkCount; chunkIndex++ {
+		set := sets[chunkIndex%setCount]
+		if set.active {
+			if err := set.drain(config); err != nil {
+				return err
+			}
+		}
+		if err := enqueuePipelineChunk(commandQueue, config, set, chunkIndex); err != nil {
+			return err
+		}
+		if err := Flush(commandQueue); err != nil {
+			return err
+		}
+	}
+	firstRemaining := config.ChunkCount - setCount
+	if firstRemaining < 0 {
+		firstRemaining = 0
+	}
+	for chunkIndex := firstRemaining; chunkIndex < config.ChunkCount; chunkIndex++ {
+		set := sets[chunkIndex%setCount]
+		if set.active {
+			if err := set.drain(config); err != nil {
+				return err
+			}
+		}
+	}
+	return nil
+}
+
+// enqueuePipelineChunk chains upload, kernel, and download of one chunk on the queue.
+func enqueuePipelineChunk(commandQueue CommandQueue, config PipelineConfig, set *pipelineSet, chunkIndex int) error {
+	ptr, size, err := config.Source(chunkIndex)
+	if err != nil {
+		return err
+	}
+	if size > config.ChunkBytes {
+		return ErrDataSizeLimitExceeded
+	}
+	var writeEvent Event
+	if err := EnqueueWriteBuffer(commandQueue, set.input, false, 0, size, ptr, nil, &writeEvent); err != nil {
+		return err
+	}
+	chunk := PipelineChunk{Index: chunkIndex, Size: size, Input: set.input, Output: set.output}
+	var kernelEvent Event
+	if err := config.Launch(commandQueue, chunk, []Event{writeEvent}, &kernelEvent); err != nil {
+		_ = ReleaseEvent(writeEvent)
+		return err
+	}
+	var readEvent Event
+	if err := EnqueueReadBuffer(commandQueue, set.output, false, 0, size, set.hostOut, []Event{kernelEvent}, &readEvent); err != nil {
+		_ = ReleaseEvent(writeEvent)
+		_ = ReleaseEvent(kernelEvent)
+		return err
+	}
+	_ = ReleaseEvent(writeEvent)
+	_ = ReleaseEvent(kernelEvent)
+	set.readEvent = readEvent
+	set.chunkIndex = chunkIndex
+	set.chunkSize = size
+	set.active = true
+	return nil
+}
+
+func newPipelineSet(context Context, chunkBytes uintptr) (*pipelineSet, error) {
+	input, err := CreateBuffer(context, MemReadOnlyFlag|MemHostWriteOnlyFlag, int(chunkBytes), nil)
+	if err != nil {
+		return nil, err
+	}
+	output, err := CreateBuffer(context, MemWriteOnlyFlag|MemHostReadOnlyFlag, int(chunkBytes), nil)
+	if err != nil {
+		_ = ReleaseMemObject(input)
+		return nil, err
+	}
+	hostOut := C.malloc(C.size_t(chunkBytes))
+	if hostOut == nil {
+		_ = ReleaseMemObject(input)
+		_ = ReleaseMemObject(output)
+		return nil, ErrOutOfMemory
+	}
+	return &pipelineSet{input: input, output: output, hostOut: hostOut}, nil
+}
+
+// drain waits for the download of the chunk held by the set and forwards the result to the sink.
+func (set *pipelineSet) drain(config PipelineConfig) error {
+	err := AwaitEvents([]Event{set.readEvent})
+	_ = ReleaseEvent(set.readEvent)
+	set.readEvent = 0
+	set.active = false
+	if err != nil {
+		return err
+	}
+	return config.Sink(set.chunkIndex, set.hostOut, set.chunkSize)
+}
+
+// release tears down the buffer set, waiting out a still-pending download beforehand.
+func (set *pipelineSet) release() {
+	if set.active {
+		_ = AwaitEvents([]Event{set.readEvent})
+		_ = ReleaseEvent(set.readEvent)
+		set.active = false
+	}
+	_ = ReleaseMemObject(set.input)
+	_ = ReleaseMemObject(set.output)
+	C.free(set.hostOut)
+}
@@ -132,9 +132,7 @@ func PlatformInfo(id PlatformID, paramName PlatformInfoName, paramSize uintptr,
 // This function does not verify the queried information is indeed of type string. It assumes the information is
 // a NUL terminated raw string and will extract the bytes as characters before that.
 func PlatformInfoString(id PlatformID, paramName PlatformInfoName) (string, error) {
-	return queryString(func(paramSize uintptr, paramValue unsafe.Pointer) (uintptr, error) {
-		return PlatformInfo(id, paramName, paramSize, paramValue)
-	})
+	return queryStringShim(queryTargetPlatform, unsafe.Pointer(id.handle()), nil, uint32(paramName))
 }
 
 // ExtensionFunctionAddressForPlatform returns the address of the extension function named by functionName
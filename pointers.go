@@ -4,6 +4,7 @@ package cl30
 import "C"
 import (
 	"runtime/cgo"
+	"sync"
 	"unsafe"
 )
 
@@ -19,10 +20,31 @@ type userData struct {
 	ptr *C.uintptr_t
 }
 
+// userDataPoolLimit is the maximum number of idle memory blocks the pool keeps for reuse.
+// Blocks beyond this limit are returned to the C heap.
+const userDataPoolLimit = 256
+
+// userDataPool keeps the memory blocks of deleted userData instances for reuse.
+// The blocks are all of the same size, so callback-heavy paths avoid a malloc/free pair
+// per callback registration.
+var userDataPool = struct {
+	sync.Mutex
+	free []*C.uintptr_t
+}{}
+
 func userDataFor(v any) (userData, error) {
-	ptr := (*C.uintptr_t)(C.malloc((C.size_t)(unsafe.Sizeof(C.uintptr_t(0)))))
+	userDataPool.Lock()
+	var ptr *C.uintptr_t
+	if count := len(userDataPool.free); count > 0 {
+		ptr = userDataPool.free[count-1]
+		userDataPool.free = userDataPool.free[:count-1]
+	}
+	userDataPool.Unlock()
 	if ptr == nil {
-		return userData{}, ErrOutOfMemory
+		ptr = (*C.uintptr_t)(C.malloc((C.size_t)(unsafe.Sizeof(C.uintptr_t(0)))))
+		if ptr == nil {
+			return userData{}, ErrOutOfMemory
+		}
 	}
 	h := cgo.NewHandle(v)
 	*ptr = C.uintptr_t(h)
@@ -44,6 +66,14 @@ func (data userData) Delete() {
 	}
 	h := cgo.Handle(*data.ptr)
 	h.Delete()
+	userDataPool.Lock()
+	if len(userDataPool.free) < userDataPoolLimit {
+		userDataPool.free = append(userDataPool.free, data.ptr)
+		userDataPool.Unlock()
+		data.ptr = nil
+		return
+	}
+	userDataPool.Unlock()
 	C.free(unsafe.Pointer(data.ptr))
 	data.ptr = nil
 }
@@ -0,0 +1,143 @@
+package cl30
+
+import (
+	"sort"
+	"unsafe"
+)
+
+// prefetchRange is one half-open address range of SVM memory to migrate.
+// The base pointer is kept alongside the addresses to avoid uintptr-to-pointer conversions.
+type prefetchRange struct {
+	ptr   unsafe.Pointer
+	start uintptr
+	end   uintptr
+}
+
+// PrefetchQueue migrates SVM ranges towards a device ahead of the kernels that touch them.
+//
+// Coarse-grain SVM pages migrate on first touch, which stalls inside the kernel. A prefetch
+// queue collects (pointer, size) hints for upcoming launches, coalesces overlapping ranges,
+// and issues them as one batched EnqueueSvmMigrateMem() call per Flush(). The returned
+// event goes into the wait list of the dependent kernel launch, which chains the migration
+// ahead of the compute without blocking the host.
+//
+// The number of migration batches in flight is bounded; once the bound is reached, Flush()
+// first waits for the oldest batch. The target device is determined by the command-queue the
+// prefetch queue was created with.
+//
+// A PrefetchQueue is not safe for concurrent use.
+type PrefetchQueue struct {
+	commandQueue CommandQueue
+	depth        int
+
+	hints    []prefetchRange
+	inFlight []Event
+
+	ptrScratch  []unsafe.Pointer
+	sizeScratch []int
+}
+
+// NewPrefetchQueue creates a prefetch queue issuing migrations on the given command-queue.
+// At most depth migration batches are in flight at any time; depth defaults to two when zero
+// or below, which lets one batch migrate while the next one is being collected.
+func NewPrefetchQueue(commandQueue CommandQueue, depth int) *PrefetchQueue {
+	if depth <= 0 {
+		depth = 2
+	}
+	return &PrefetchQueue{commandQueue: commandQueue, depth: depth}
+}
+
+// Hint registers that an upcoming kernel launch will touch size bytes at svmPtr.
+// Hints accumulate until the next Flush().
+func (queue *PrefetchQueue) Hint(svmPtr unsafe.Pointer, size int) {
+	if (svmPtr == nil) || (size <= 0) {
+		return
+	}
+	start := uintptr(svmPtr)
+	queue.hints = append(queue.hints, prefetchRange{ptr: svmPtr, start: start, end: start + uintptr(size)})
+}
+
+// HintCount returns the number of hints collected since the last Flush().
+func (queue *PrefetchQueue) HintCount() int {
+	return len(queue.hints)
+}
+
+// Flush coalesces all collected hints and enqueues them as one migration batch.
+//
+// The returned event completes when the migration is done; pass it in the wait list of the
+// dependent kernel launches. The event stays owned by the prefetch queue and remains valid
+// until the batch is waited out by a later Flush() exceeding the depth, or by Wait().
+// With no hints collected, Flush returns a zero event and no error.
+func (queue *PrefetchQueue) Flush(flags MemMigrationFlags) (Event, error) {
+	if len(queue.hints) == 0 {
+		return 0, nil
+	}
+	queue.coalesce()
+	ptrs := queue.ptrScratch[:0]
+	sizes := queue.sizeScratch[:0]
+	for _, hint := range queue.hints {
+		ptrs = append(ptrs, hint.ptr)
+		sizes = append(sizes, int(hint.end-hint.start))
+	}
+	queue.ptrScratch = ptrs
+	queue.sizeScratch = sizes
+	queue.hints = queue.hints[:0]
+	if len(queue.inFlight) >= queue.depth {
+		if err := queue.waitOldest(); err != nil {
+			return 0, err
+		}
+	}
+	var event Event
+	if err := EnqueueSvmMigrateMem(queue.commandQueue, ptrs, sizes, flags, nil, &event); err != nil {
+		return 0, err
+	}
+	if err := Flush(queue.commandQueue); err != nil {
+		_ = ReleaseEvent(event)
+		return 0, err
+	}
+	queue.inFlight = append(queue.inFlight, event)
+	return event, nil
+}
+
+// Wait drains all migration batches still in flight.
+func (queue *PrefetchQueue) Wait() error {
+	var firstError error
+	for len(queue.inFlight) > 0 {
+		err := queue.waitOldest()
+		if (err != nil) && (firstError == nil) {
+			firstError = err
+		}
+	}
+	return firstError
+}
+
+// waitOldest waits for the oldest in-flight batch and releases its event.
+func (queue *PrefetchQueue) waitOldest() error {
+	event := queue.inFlight[0]
+	queue.inFlight = queue.inFlight[:copy(queue.inFlight, queue.inFlight[1:])]
+	err := AwaitEvents([]Event{event})
+	_ = ReleaseEvent(event)
+	return err
+}
+
+// coalesce sorts the collected hints by address and merges overlapping ranges.
+//
+// Each migrated range must lie within a single SVM allocation. Overlapping ranges share bytes
+// and therefore share that allocation, so their union is valid; merely adjacent ranges may come
+// from two distinct allocations that happen to abut in address space and are kept separate.
+func (queue *PrefetchQueue) coalesce() {
+	sort.Slice(queue.hints, func(i, j int) bool {
+		return queue.hints[i].start < queue.hints[j].start
+	})
+	merged := queue.hints[:0]
+	for _, hint := range queue.hints {
+		if (len(merged) > 0) && (hint.start < merged[len(merged)-1].end) {
+			if hint.end > merged[len(merged)-1].end {
+				merged[len(merged)-1].end = hint.end
+			}
+			continue
+		}
+		merged = append(merged, hint)
+	}
+	queue.hints = merged
+}
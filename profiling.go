@@ -0,0 +1,218 @@
+package cl30
+
+// #include "api.h"
+// extern void cl30CollectProfilingSamples(cl_event *events, cl_uint count, cl_ulong *timestamps, cl_int *states);
+import "C"
+import (
+	"sort"
+	"sync"
+	"time"
+)
+
+// ProfilingSample holds the device timestamps of one profiled command.
+// All timestamps are device time counters in nanoseconds, as per EventProfilingInfo().
+type ProfilingSample struct {
+	// Label identifies the command, as provided to ProfilingCollector.Track().
+	Label string
+	// Queued is the time the command was enqueued by the host.
+	Queued uint64
+	// Submit is the time the command was submitted to the device.
+	Submit uint64
+	// Start is the time the command started execution on the device.
+	Start uint64
+	// End is the time the command finished execution on the device.
+	End uint64
+}
+
+// QueuedDuration returns the time the command spent in the command-queue before submission.
+func (sample ProfilingSample) QueuedDuration() time.Duration {
+	return time.Duration(sample.Submit - sample.Queued)
+}
+
+// SubmitDuration returns the time between submission to the device and the start of execution.
+func (sample ProfilingSample) SubmitDuration() time.Duration {
+	return time.Duration(sample.Start - sample.Submit)
+}
+
+// ExecutionDuration returns the time the command spent executing on the device.
+func (sample ProfilingSample) ExecutionDuration() time.Duration {
+	return time.Duration(sample.End - sample.Start)
+}
+
+// profilingEntry is a tracked event that has not yet been collected.
+type profilingEntry struct {
+	label string
+	event Event
+}
+
+// ProfilingCollector gathers execution timestamps from events of commands enqueued on a
+// command-queue created with QueueProfilingEnable.
+//
+// Track() merely stores the event, keeping the enqueue path free of profiling queries.
+// The timestamp queries happen in Collect(), which harvests all completed events with a single
+// cgo crossing and is intended to be called off the hot path - periodically, or after a workload
+// has drained. Collected events are released by the collector.
+//
+// Sample storage is reused across Collect() calls, so steady-state collection does not allocate.
+// Stats() summarizes the collected execution durations per label as percentiles.
+//
+// A ProfilingCollector is safe for concurrent use by multiple goroutines.
+type ProfilingCollector struct {
+	mutex     sync.Mutex
+	pending   []profilingEntry
+	samples   []ProfilingSample
+	durations map[string][]time.Duration
+	dropped   int
+
+	eventScratch []C.cl_event
+	timeScratch  []C.cl_ulong
+	stateScratch []C.cl_int
+}
+
+// Track stores the event for later collection under the given label.
+// The collector takes over the event reference and releases it once the sample was collected
+// or dropped.
+func (collector *ProfilingCollector) Track(label string, event Event) {
+	collector.mutex.Lock()
+	defer collector.mutex.Unlock()
+	collector.pending = append(collector.pending, profilingEntry{label: label, event: event})
+}
+
+// PendingCount returns the number of tracked events that have not yet been collected.
+func (collector *ProfilingCollector) PendingCount() int {
+	collector.mutex.Lock()
+	defer collector.mutex.Unlock()
+	return len(collector.pending)
+}
+
+// DroppedCount returns the number of events that were discarded because their profiling
+// information could not be queried.
+func (collector *ProfilingCollector) DroppedCount() int {
+	collector.mutex.Lock()
+	defer collector.mutex.Unlock()
+	return collector.dropped
+}
+
+// Collect queries the timestamps of all tracked events whose command has completed and returns
+// the resulting samples. Events of commands still in flight remain tracked for a later call.
+//
+// Events whose profiling information cannot be queried are dropped and counted in DroppedCount().
+// The returned slice is reused by the collector; it is only valid until the next call to Collect().
+func (collector *ProfilingCollector) Collect() []ProfilingSample {
+	collector.mutex.Lock()
+	defer collector.mutex.Unlock()
+	collector.samples = collector.samples[:0]
+	count := len(collector.pending)
+	if count == 0 {
+		return collector.samples
+	}
+	collector.growScratch(count)
+	for i, entry := range collector.pending {
+		collector.eventScratch[i] = entry.event.handle()
+	}
+	// One crossing harvests the execution status and, for completed commands, all four
+	// timestamps of every pending event. A state of zero means collected, a positive state is
+	// the execution status of a command still in flight, a negative state is a query error.
+	C.cl30CollectProfilingSamples(&collector.eventScratch[0], C.cl_uint(count),
+		&collector.timeScratch[0], &collector.stateScratch[0])
+	remaining := collector.pending[:0]
+	for i, entry := range collector.pending {
+		state := collector.stateScratch[i]
+		if state > 0 {
+			remaining = append(remaining, entry)
+			continue
+		}
+		_ = ReleaseEvent(entry.event)
+		if state < 0 {
+			collector.dropped++
+			continue
+		}
+		times := collector.timeScratch[i*4 : i*4+4]
+		sample := ProfilingSample{
+			Label:  entry.label,
+			Queued: uint64(times[0]),
+			Submit: uint64(times[1]),
+			Start:  uint64(times[2]),
+			End:    uint64(times[3]),
+		}
+		collector.samples = append(collector.samples, sample)
+		collector.recordDuration(entry.label, sample.ExecutionDuration())
+	}
+	collector.pending = remaining
+	return collector.samples
+}
+
+// growScratch sizes the query scratch arrays for the given event count.
+// The caller must hold the collector mutex.
+func (collector *ProfilingCollector) growScratch(count int) {
+	if cap(collector.eventScratch) < count {
+		collector.eventScratch = make([]C.cl_event, count)
+		collector.timeScratch = make([]C.cl_ulong, count*4)
+		collector.stateScratch = make([]C.cl_int, count)
+		return
+	}
+	collector.eventScratch = collector.eventScratch[:count]
+	collector.timeScratch = collector.timeScratch[:count*4]
+	collector.stateScratch = collector.stateScratch[:count]
+}
+
+// recordDuration accumulates one execution duration for Stats().
+// The caller must hold the collector mutex.
+func (collector *ProfilingCollector) recordDuration(label string, duration time.Duration) {
+	if collector.durations == nil {
+		collector.durations = map[string][]time.Duration{}
+	}
+	collector.durations[label] = append(collector.durations[label], duration)
+}
+
+// ProfilingStats summarizes the execution durations collected under one label.
+// The percentiles are nearest-rank over all collected samples of the label.
+type ProfilingStats struct {
+	// Label identifies the command, as provided to ProfilingCollector.Track().
+	Label string
+	// Count is the number of samples the percentiles are based on.
+	Count int
+	// P50, P95, and P99 are the percentiles of ProfilingSample.ExecutionDuration().
+	P50 time.Duration
+	P95 time.Duration
+	P99 time.Duration
+}
+
+// Stats returns per-label percentiles over the execution durations of all samples collected so
+// far, sorted by label. The records accumulate across Collect() calls until ResetStats().
+func (collector *ProfilingCollector) Stats() []ProfilingStats {
+	collector.mutex.Lock()
+	defer collector.mutex.Unlock()
+	stats := make([]ProfilingStats, 0, len(collector.durations))
+	for label, durations := range collector.durations {
+		sort.Slice(durations, func(i, j int) bool { return durations[i] < durations[j] })
+		stats = append(stats, ProfilingStats{
+			Label: label,
+			Count: len(durations),
+			P50:   percentileOf(durations, 50),
+			P95:   percentileOf(durations, 95),
+			P99:   percentileOf(durations, 99),
+		})
+	}
+	sort.Slice(stats, func(i, j int) bool { return stats[i].Label < stats[j].Label })
+	return stats
+}
+
+// ResetStats drops all duration records accumulated for Stats().
+func (collector *ProfilingCollector) ResetStats() {
+	collector.mutex.Lock()
+	defer collector.mutex.Unlock()
+	collector.durations = nil
+}
+
+// percentileOf returns the nearest-rank percentile of an ascending duration slice.
+func percentileOf(sorted []time.Duration, percentile int) time.Duration {
+	if len(sorted) == 0 {
+		return 0
+	}
+	rank := ((len(sorted) * percentile) + 99) / 100
+	if rank < 1 {
+		rank = 1
+	}
+	return sorted[rank-1]
+}
@@ -52,3 +52,21 @@ cl_program cl30LinkProgram(cl_context context,
         (userData != NULL) ? cl30CProgramLinkCallback : NULL, userData,
         errReturn);
 }
+
+cl_int cl30SetProgramSpecializationConstants(cl_program program, cl_uint count,
+    cl_uint const *ids, size_t const *sizes, size_t const *offsets, void const *data,
+    cl_uint *failureIndex)
+{
+    cl_uint i;
+    for (i = 0; i < count; i++)
+    {
+        cl_int status = clSetProgramSpecializationConstant(program, ids[i], sizes[i],
+            (char const *)(data) + offsets[i]);
+        if (status != CL_SUCCESS)
+        {
+            *failureIndex = i;
+            return status;
+        }
+    }
+    return CL_SUCCESS;
+}
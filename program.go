@@ -459,9 +459,8 @@ func ProgramBuildInfo(program Program, device DeviceID, paramName ProgramBuildIn
 // This function does not verify the queried information is indeed of type string. It assumes the information is
 // a NUL terminated raw string and will extract the bytes as characters before that.
 func ProgramBuildInfoString(program Program, device DeviceID, paramName ProgramBuildInfoName) (string, error) {
-	return queryString(func(paramSize uintptr, paramValue unsafe.Pointer) (uintptr, error) {
-		return ProgramBuildInfo(program, device, paramName, paramSize, paramValue)
-	})
+	return queryStringShim(queryTargetProgramBuild,
+		unsafe.Pointer(program.handle()), unsafe.Pointer(device.handle()), uint32(paramName))
 }
 
 // ProgramInfoName identifies properties of a program, which can be queried with ProgramInfo().
@@ -608,7 +607,5 @@ func ProgramInfo(program Program, paramName ProgramInfoName, paramSize uintptr,
 // This function does not verify the queried information is indeed of type string. It assumes the information is
 // a NUL terminated raw string and will extract the bytes as characters before that.
 func ProgramInfoString(program Program, paramName ProgramInfoName) (string, error) {
-	return queryString(func(paramSize uintptr, paramValue unsafe.Pointer) (uintptr, error) {
-		return ProgramInfo(program, paramName, paramSize, paramValue)
-	})
+	return queryStringShim(queryTargetProgram, unsafe.Pointer(program.handle()), nil, uint32(paramName))
 }
@@ -0,0 +1,170 @@
+package cl30
+
+import (
+	"fmt"
+	"runtime"
+	"strings"
+	"sync"
+	"unsafe"
+)
+
+// BuildJob describes one program build of a BuildAll() run.
+type BuildJob struct {
+	// Program is the program to build.
+	Program Program
+	// Devices lists the devices to build for. If empty, the program is built for all devices it
+	// is associated with.
+	Devices []DeviceID
+	// Options is the build options string, as per BuildProgram().
+	Options string
+}
+
+// BuildFailure describes one failed job of a BuildAll() run.
+type BuildFailure struct {
+	// Program is the program of the failed job.
+	Program Program
+	// Err is the reported reason.
+	Err error
+	// Logs holds the ProgramBuildLogInfo of every device the job built for, keyed by device.
+	// Logs may be empty if querying them failed as well.
+	Logs map[DeviceID]string
+}
+
+// BuildAllError aggregates the failures of a BuildAll() run.
+type BuildAllError struct {
+	// Failures holds one entry per failed job.
+	Failures []BuildFailure
+}
+
+// Error returns a summary of all failed jobs, including their build logs.
+func (err *BuildAllError) Error() string {
+	var text strings.Builder
+	_, _ = fmt.Fprintf(&text, "%d program build(s) failed", len(err.Failures))
+	for _, failure := range err.Failures {
+		_, _ = fmt.Fprintf(&text, "\nprogram %v: %v", failure.Program, failure.Err)
+		for device, log := range failure.Logs {
+			trimmed := strings.TrimSpace(log)
+			if len(trimmed) > 0 {
+				_, _ = fmt.Fprintf(&text, "\ndevice %v:\n%s", device, trimmed)
+			}
+		}
+	}
+	return text.String()
+}
+
+// BuildAll builds many programs concurrently.
+//
+// Each job is submitted with the asynchronous callback variant of BuildProgram(), so a single
+// goroutine drives up to maxConcurrent builds in flight at any time. With maxConcurrent at zero
+// or below, the number of logical CPUs is used. Bounding concurrency keeps the memory footprint
+// of the driver compilers in check.
+//
+// Note that a program object supports only one outstanding build operation, which is why each
+// job builds all its devices in one call; to build the devices of one program in parallel,
+// submit separate jobs with separate program objects (for example created from the same source).
+//
+// BuildAll returns once all jobs have completed. If any of them failed, the returned error is a
+// *BuildAllError listing every failed job together with the build logs of its devices.
+func BuildAll(jobs []BuildJob, maxConcurrent int) error {
+	if maxConcurrent <= 0 {
+		maxConcurrent = runtime.NumCPU()
+	}
+	slots := make(chan struct{}, maxConcurrent)
+	var wg sync.WaitGroup
+	var mutex sync.Mutex
+	var failures []BuildFailure
+	fail := func(job BuildJob, err error) {
+		mutex.Lock()
+		defer mutex.Unlock()
+		failures = append(failures, BuildFailure{
+			Program: job.Program,
+			Err:     err,
+			Logs:    buildLogsOf(job),
+		})
+	}
+	for _, job := range jobs {
+		slots <- struct{}{}
+		wg.Add(1)
+		job := job
+		finished := func() {
+			defer wg.Done()
+			defer func() { <-slots }()
+			if err := verifyBuildOf(job); err != nil {
+				fail(job, err)
+			}
+		}
+		err := BuildProgram(job.Program, job.Devices, job.Options, finished)
+		if err != nil {
+			fail(job, err)
+			wg.Done()
+			<-slots
+		}
+	}
+	wg.Wait()
+	if len(failures) > 0 {
+		return &BuildAllError{Failures: failures}
+	}
+	return nil
+}
+
+// verifyBuildOf checks the build status of every device of the job, returning the error of the
+// first device whose build did not succeed.
+func verifyBuildOf(job BuildJob) error {
+	devices, err := buildJobDevices(job)
+	if err != nil {
+		return err
+	}
+	for _, device := range devices {
+		var status BuildStatus
+		_, err := ProgramBuildInfo(job.Program, device, ProgramBuildStatusInfo,
+			unsafe.Sizeof(status), unsafe.Pointer(&status))
+		if err != nil {
+			return err
+		}
+		if status != BuildSuccessStatus {
+			return ErrBuildProgramFailure
+		}
+	}
+	return nil
+}
+
+// buildLogsOf collects the build logs of all devices of the job. Devices whose log cannot be
+// queried are skipped.
+func buildLogsOf(job BuildJob) map[DeviceID]string {
+	devices, err := buildJobDevices(job)
+	if err != nil {
+		return nil
+	}
+	logs := make(map[DeviceID]string, len(devices))
+	for _, device := range devices {
+		log, err := ProgramBuildInfoString(job.Program, device, ProgramBuildLogInfo)
+		if err != nil {
+			continue
+		}
+		logs[device] = log
+	}
+	return logs
+}
+
+// buildJobDevices resolves the devices a job builds for, querying the program if the job does
+// not list them explicitly.
+func buildJobDevices(job BuildJob) ([]DeviceID, error) {
+	if len(job.Devices) > 0 {
+		return job.Devices, nil
+	}
+	var deviceCount uint32
+	_, err := ProgramInfo(job.Program, ProgramNumDevicesInfo, unsafe.Sizeof(deviceCount), unsafe.Pointer(&deviceCount))
+	if err != nil {
+		return nil, err
+	}
+	if deviceCount == 0 {
+		return nil, nil
+	}
+	devices := make([]DeviceID, deviceCount)
+	_, err = ProgramInfo(job.Program, ProgramDevicesInfo,
+		uintptr(deviceCount)*unsafe.Sizeof(DeviceID(0)), unsafe.Pointer(&devices[0]))
+	if err != nil {
+		return nil, err
+	}
+	return devices, nil
+}
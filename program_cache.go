@@ -0,0 +1,193 @@
+package cl30
+
+// #include "api.h"
+import "C"
+import (
+	"crypto/sha256"
+	"encoding/hex"
+	"os"
+	"path/filepath"
+	"unsafe"
+)
+
+// ProgramCache persists built program binaries in a directory so that subsequent process starts can
+// skip the compilation of unchanged sources.
+//
+// Entries are keyed by a hash over the program sources, the build options, and the name and driver
+// version of the device the binary was built for. A change in any of these yields a different key,
+// causing an automatic rebuild from source.
+//
+// The cache is best-effort: failures to load or store binaries - including binaries rejected by the
+// driver - silently fall back to a regular build from source.
+type ProgramCache struct {
+	dirPath string
+}
+
+// NewProgramCache returns a cache that stores program binaries in the given directory.
+// The directory is created if it does not yet exist.
+func NewProgramCache(dirPath string) (*ProgramCache, error) {
+	if err := os.MkdirAll(dirPath, 0o755); err != nil {
+		return nil, err
+	}
+	return &ProgramCache{dirPath: dirPath}, nil
+}
+
+// BuildProgramWithSource creates a program from the given sources and builds it for the given
+// devices, reusing cached binaries where available.
+//
+// If a cached binary exists for every requested device, the program is created with
+// CreateProgramWithBinary() and built from there. Otherwise, the program is created with
+// CreateProgramWithSource(), built, and the resulting binaries are stored in the cache.
+//
+// In case the build itself fails, the program object is returned together with the error so that
+// the build log can still be queried with ProgramBuildInfoString().
+func (cache *ProgramCache) BuildProgramWithSource(context Context, devices []DeviceID, sources []string, options string) (Program, error) {
+	keys, keysErr := cache.keysFor(devices, sources, options)
+	if keysErr == nil {
+		if binaries, ok := cache.loadBinaries(keys); ok {
+			program, _, err := CreateProgramWithBinary(context, devices, binaries)
+			if err == nil {
+				err = BuildProgram(program, devices, options, nil)
+				if err == nil {
+					return program, nil
+				}
+				_ = ReleaseProgram(program)
+			}
+		}
+	}
+	program, err := CreateProgramWithSource(context, sources)
+	if err != nil {
+		return 0, err
+	}
+	err = BuildProgram(program, devices, options, nil)
+	if err != nil {
+		return program, err
+	}
+	if keysErr == nil {
+		cache.storeBinaries(program, devices, keys)
+	}
+	return program, nil
+}
+
+// keysFor determines the cache key for every requested device.
+func (cache *ProgramCache) keysFor(devices []DeviceID, sources []string, options string) ([]string, error) {
+	keys := make([]string, len(devices))
+	for i, device := range devices {
+		deviceName, err := DeviceInfoString(device, DeviceNameInfo)
+		if err != nil {
+			return nil, err
+		}
+		driverVersion, err := DeviceInfoString(device, DriverVersionInfo)
+		if err != nil {
+			return nil, err
+		}
+		hasher := sha256.New()
+		for _, source := range sources {
+			_, _ = hasher.Write([]byte(source))
+		}
+		_, _ = hasher.Write([]byte(options))
+		_, _ = hasher.Write([]byte(deviceName))
+		_, _ = hasher.Write([]byte(driverVersion))
+		keys[i] = hex.EncodeToString(hasher.Sum(nil))
+	}
+	return keys, nil
+}
+
+// loadBinaries reads the cached binary for every key. It reports false if any entry is missing.
+func (cache *ProgramCache) loadBinaries(keys []string) ([][]byte, bool) {
+	binaries := make([][]byte, len(keys))
+	for i, key := range keys {
+		binary, err := os.ReadFile(cache.entryPath(key))
+		if (err != nil) || (len(binary) == 0) {
+			return nil, false
+		}
+		binaries[i] = binary
+	}
+	return binaries, true
+}
+
+// storeBinaries queries the binaries of a built program and writes them to the cache directory.
+// Storage is best-effort; failures are ignored.
+func (cache *ProgramCache) storeBinaries(program Program, devices []DeviceID, keys []string) {
+	programDevices, binaries, err := programBinaries(program)
+	if err != nil {
+		return
+	}
+	for i, programDevice := range programDevices {
+		if len(binaries[i]) == 0 {
+			continue
+		}
+		for j, device := range devices {
+			if device != programDevice {
+				continue
+			}
+			tempFile, err := os.CreateTemp(cache.dirPath, keys[j]+".*")
+			if err != nil {
+				continue
+			}
+			_, writeErr := tempFile.Write(binaries[i])
+			closeErr := tempFile.Close()
+			if (writeErr != nil) || (closeErr != nil) {
+				_ = os.Remove(tempFile.Name())
+				continue
+			}
+			_ = os.Rename(tempFile.Name(), cache.entryPath(keys[j]))
+		}
+	}
+}
+
+// entryPath returns the file name of a cache entry.
+func (cache *ProgramCache) entryPath(key string) string {
+	return filepath.Join(cache.dirPath, key+".bin")
+}
+
+// programBinaries returns the devices associated with a program, together with the program binary
+// for each of them. Devices for which no binary is available yield an empty entry.
+func programBinaries(program Program) ([]DeviceID, [][]byte, error) {
+	var deviceCount uint32
+	_, err := ProgramInfo(program, ProgramNumDevicesInfo, unsafe.Sizeof(deviceCount), unsafe.Pointer(&deviceCount))
+	if err != nil {
+		return nil, nil, err
+	}
+	if deviceCount == 0 {
+		return nil, nil, nil
+	}
+	devices := make([]DeviceID, deviceCount)
+	_, err = ProgramInfo(program, ProgramDevicesInfo, uintptr(deviceCount)*unsafe.Sizeof(DeviceID(0)), unsafe.Pointer(&devices[0]))
+	if err != nil {
+		return nil, nil, err
+	}
+	sizes := make([]uintptr, deviceCount)
+	_, err = ProgramInfo(program, ProgramBinarySizesInfo, uintptr(deviceCount)*unsafe.Sizeof(uintptr(0)), unsafe.Pointer(&sizes[0]))
+	if err != nil {
+		return nil, nil, err
+	}
+	rawBinaries := make([]uintptr, deviceCount)
+	defer func() {
+		for _, rawBinary := range rawBinaries {
+			C.free(unsafe.Pointer(rawBinary))
+		}
+	}()
+	for i, size := range sizes {
+		if size == 0 {
+			continue
+		}
+		rawBinary := C.malloc(C.size_t(size))
+		if rawBinary == nil {
+			return nil, nil, ErrOutOfMemory
+		}
+		rawBinaries[i] = uintptr(rawBinary)
+	}
+	_, err = ProgramInfo(program, ProgramBinariesInfo, uintptr(deviceCount)*unsafe.Sizeof(uintptr(0)), unsafe.Pointer(&rawBinaries[0]))
+	if err != nil {
+		return nil, nil, err
+	}
+	binaries := make([][]byte, deviceCount)
+	for i, size := range sizes {
+		if size == 0 {
+			continue
+		}
+		binaries[i] = C.GoBytes(unsafe.Pointer(rawBinaries[i]), C.int(size))
+	}
+	return devices, binaries, nil
+}
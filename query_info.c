@@ -0,0 +1,41 @@
+#include "query_info.h"
+
+static cl_int cl30QueryInfoDispatch(cl_uint target, void *object, void *secondary, cl_uint paramName,
+    size_t paramSize, void *paramValue, size_t *sizeReturn)
+{
+    switch (target)
+    {
+    case CL30_QUERY_TARGET_PLATFORM:
+        return clGetPlatformInfo((cl_platform_id)object, (cl_platform_info)paramName,
+            paramSize, paramValue, sizeReturn);
+    case CL30_QUERY_TARGET_DEVICE:
+        return clGetDeviceInfo((cl_device_id)object, (cl_device_info)paramName,
+            paramSize, paramValue, sizeReturn);
+    case CL30_QUERY_TARGET_KERNEL:
+        return clGetKernelInfo((cl_kernel)object, (cl_kernel_info)paramName,
+            paramSize, paramValue, sizeReturn);
+    case CL30_QUERY_TARGET_PROGRAM:
+        return clGetProgramInfo((cl_program)object, (cl_program_info)paramName,
+            paramSize, paramValue, sizeReturn);
+    case CL30_QUERY_TARGET_PROGRAM_BUILD:
+        return clGetProgramBuildInfo((cl_program)object, (cl_device_id)secondary, (cl_program_build_info)paramName,
+            paramSize, paramValue, sizeReturn);
+    default:
+        return CL_INVALID_VALUE;
+    }
+}
+
+cl_int cl30QueryInfoString(cl_uint target, void *object, void *secondary, cl_uint paramName,
+    size_t bufferSize, void *buffer, size_t *requiredSize)
+{
+    cl_int status = cl30QueryInfoDispatch(target, object, secondary, paramName, 0, NULL, requiredSize);
+    if (status != CL_SUCCESS)
+    {
+        return status;
+    }
+    if ((*requiredSize == 0) || (*requiredSize > bufferSize))
+    {
+        return CL_SUCCESS;
+    }
+    return cl30QueryInfoDispatch(target, object, secondary, paramName, *requiredSize, buffer, NULL);
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "api.h"
+
+// Query targets understood by cl30QueryInfoString(), selecting the clGet*Info() function to call.
+#define CL30_QUERY_TARGET_PLATFORM 0
+#define CL30_QUERY_TARGET_DEVICE 1
+#define CL30_QUERY_TARGET_KERNEL 2
+#define CL30_QUERY_TARGET_PROGRAM 3
+#define CL30_QUERY_TARGET_PROGRAM_BUILD 4
+
+cl_int cl30QueryInfoString(cl_uint target, void *object, void *secondary, cl_uint paramName,
+    size_t bufferSize, void *buffer, size_t *requiredSize);
@@ -0,0 +1,141 @@
+package cl30
+
+// #include "api.h"
+// extern cl_int cl30FlushQueues(cl_command_queue *queues, cl_uint count, cl_int finish);
+import "C"
+import (
+	"sync"
+	"unsafe"
+)
+
+// QueuePool hands out command-queues for per-worker use.
+//
+// Sharing one command-queue across goroutines serializes all enqueue traffic on the driver's
+// queue lock. A pool instead gives every worker its own queue for the duration of a task:
+// Get() returns an idle queue or lazily creates one - up to a configurable cap - and Put()
+// returns it for reuse. As long as the number of concurrent workers stays within the cap, the
+// enqueue fast path runs uncontended.
+//
+// A QueuePool is safe for concurrent use.
+type QueuePool struct {
+	context    Context
+	device     DeviceID
+	properties []CommandQueueProperty
+	limit      int
+
+	mutex   sync.Mutex
+	cond    *sync.Cond
+	idle    []CommandQueue
+	created int
+}
+
+// NewQueuePool creates a pool of command-queues for the given device.
+//
+// Queues are created lazily with CreateCommandQueueWithProperties() and the given properties.
+// At most limit queues exist at any time; with limit at zero or below, ErrInvalidValue is
+// returned.
+func NewQueuePool(context Context, device DeviceID, limit int, properties ...CommandQueueProperty) (*QueuePool, error) {
+	if limit <= 0 {
+		return nil, ErrInvalidValue
+	}
+	pool := &QueuePool{
+		context:    context,
+		device:     device,
+		properties: properties,
+		limit:      limit,
+	}
+	pool.cond = sync.NewCond(&pool.mutex)
+	return pool, nil
+}
+
+// Get returns a command-queue for exclusive use by the caller.
+//
+// An idle queue is preferred; if none is available and the cap is not yet reached, a new queue
+// is created. Otherwise the call blocks until another worker calls Put().
+func (pool *QueuePool) Get() (CommandQueue, error) {
+	pool.mutex.Lock()
+	for {
+		if count := len(pool.idle); count > 0 {
+			queue := pool.idle[count-1]
+			pool.idle = pool.idle[:count-1]
+			pool.mutex.Unlock()
+			return queue, nil
+		}
+		if pool.created < pool.limit {
+			pool.created++
+			pool.mutex.Unlock()
+			queue, err := CreateCommandQueueWithProperties(pool.context, pool.device, pool.properties...)
+			if err != nil {
+				pool.mutex.Lock()
+				pool.created--
+				pool.cond.Signal()
+				pool.mutex.Unlock()
+				return 0, err
+			}
+			return queue, nil
+		}
+		pool.cond.Wait()
+	}
+}
+
+// Put returns a command-queue previously handed out by Get() to the pool.
+// Commands still queued on it remain queued; they are picked up by FlushAll() and FinishAll().
+func (pool *QueuePool) Put(queue CommandQueue) {
+	pool.mutex.Lock()
+	defer pool.mutex.Unlock()
+	pool.idle = append(pool.idle, queue)
+	pool.cond.Signal()
+}
+
+// FlushAll issues a flush on all idle queues of the pool in one cgo crossing.
+// Queues currently handed out to workers are not covered.
+func (pool *QueuePool) FlushAll() error {
+	return pool.flushIdle(0)
+}
+
+// FinishAll blocks until all commands on all idle queues of the pool have completed, in one
+// cgo crossing. Queues currently handed out to workers are not covered.
+func (pool *QueuePool) FinishAll() error {
+	return pool.flushIdle(1)
+}
+
+// flushIdle runs the batched flush shim over a snapshot of the idle queues.
+// The queues stay in the pool while the shim runs; clFlush and clFinish are thread-safe, so a
+// worker picking one up concurrently is harmless.
+func (pool *QueuePool) flushIdle(finish C.cl_int) error {
+	pool.mutex.Lock()
+	queues := make([]CommandQueue, len(pool.idle))
+	copy(queues, pool.idle)
+	pool.mutex.Unlock()
+	if len(queues) == 0 {
+		return nil
+	}
+	status := C.cl30FlushQueues((*C.cl_command_queue)(unsafe.Pointer(&queues[0])), C.cl_uint(len(queues)), finish)
+	if status != C.CL_SUCCESS {
+		return StatusError(status)
+	}
+	return nil
+}
+
+// Release finishes and releases all idle queues of the pool.
+// Queues still handed out to workers must be Put() back before calling Release().
+// The first encountered error is returned, the remaining queues are released regardless.
+func (pool *QueuePool) Release() error {
+	pool.mutex.Lock()
+	queues := pool.idle
+	pool.idle = nil
+	pool.created -= len(queues)
+	pool.mutex.Unlock()
+	var firstError error
+	for _, queue := range queues {
+		err := Finish(queue)
+		if (err != nil) && (firstError == nil) {
+			firstError = err
+		}
+		err = ReleaseCommandQueue(queue)
+		if (err != nil) && (firstError == nil) {
+			firstError = err
+		}
+	}
+	return firstError
+}
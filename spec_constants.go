@@ -0,0 +1,197 @@
+package cl30
+
+// #include "api.h"
+// extern cl_int cl30SetProgramSpecializationConstants(cl_program program, cl_uint count,
+//     cl_uint const *ids, size_t const *sizes, size_t const *offsets, void const *data,
+//     cl_uint *failureIndex);
+import "C"
+import (
+	"crypto/sha256"
+	"encoding/binary"
+	"sort"
+	"sync"
+	"unsafe"
+)
+
+// SpecConstantSet stages specialization constants and applies them with a single cgo crossing.
+//
+// Setting dozens of constants before a build through individual calls to
+// SetProgramSpecializationConstant() costs one crossing each. A set stages the (id, size, value)
+// tuples - copying the values into one contiguous host buffer - and Apply() forwards them
+// through a C loop over clSetProgramSpecializationConstant().
+//
+// A set can be reused across programs and variants via Reset(), keeping its backing arrays.
+// It is not safe for concurrent use.
+type SpecConstantSet struct {
+	ids     []C.cl_uint
+	sizes   []C.size_t
+	offsets []C.size_t
+	data    []byte
+}
+
+// Len returns the number of staged constants.
+func (set *SpecConstantSet) Len() int {
+	return len(set.ids)
+}
+
+// Reset drops all staged constants, keeping the backing arrays for reuse.
+func (set *SpecConstantSet) Reset() {
+	set.ids = set.ids[:0]
+	set.sizes = set.sizes[:0]
+	set.offsets = set.offsets[:0]
+	set.data = set.data[:0]
+}
+
+// Set stages one constant, equivalent to SetProgramSpecializationConstant() with the same
+// parameters. The value is copied, so the pointed-to memory is free to change afterwards.
+func (set *SpecConstantSet) Set(id uint32, size uintptr, value unsafe.Pointer) {
+	set.ids = append(set.ids, C.cl_uint(id))
+	set.sizes = append(set.sizes, C.size_t(size))
+	set.offsets = append(set.offsets, C.size_t(len(set.data)))
+	set.data = append(set.data, unsafe.Slice((*byte)(value), size)...)
+}
+
+// Apply forwards all staged constants to the program, in staging order, and returns the number
+// of constants that were set. Application stops at the first failure, so on error the returned
+// count identifies the staged constant that failed.
+func (set *SpecConstantSet) Apply(program Program) (int, error) {
+	if len(set.ids) == 0 {
+		return 0, nil
+	}
+	var failureIndex C.cl_uint
+	status := C.cl30SetProgramSpecializationConstants(
+		program.handle(),
+		C.cl_uint(len(set.ids)),
+		&set.ids[0],
+		&set.sizes[0],
+		&set.offsets[0],
+		unsafe.Pointer(&set.data[0]),
+		&failureIndex)
+	if status != C.CL_SUCCESS {
+		return int(failureIndex), StatusError(status)
+	}
+	return len(set.ids), nil
+}
+
+// hash returns a digest over the staged constants in staging order.
+func (set *SpecConstantSet) hash() [sha256.Size]byte {
+	digest := sha256.New()
+	var scratch [8]byte
+	for i := range set.ids {
+		binary.LittleEndian.PutUint32(scratch[:4], uint32(set.ids[i]))
+		digest.Write(scratch[:4])
+		binary.LittleEndian.PutUint64(scratch[:], uint64(set.sizes[i]))
+		digest.Write(scratch[:])
+	}
+	digest.Write(set.data)
+	var sum [sha256.Size]byte
+	copy(sum[:], digest.Sum(nil))
+	return sum
+}
+
+// SpecVariantCache builds and caches specialization variants of one intermediate-language module.
+//
+// Workloads that build the same SPIR-V module with many different constant sets pay a full
+// driver build per variant, even when a variant repeats. The cache keys built programs by a
+// digest over the device set, the build options, and the constant set: a hit returns the
+// existing program retained via RetainProgram(), a miss creates a program from the module,
+// applies the constants, builds it, and stores it.
+//
+// A SpecVariantCache is safe for concurrent use. All builds through one cache serialize; use
+// separate caches when variant builds themselves should overlap.
+type SpecVariantCache struct {
+	context Context
+	il      []byte
+
+	mutex    sync.Mutex
+	variants map[[sha256.Size]byte]Program
+}
+
+// NewSpecVariantCache creates a variant cache over the given intermediate-language module.
+// The il bytes are referenced, not copied; they must stay unmodified for the cache lifetime.
+func NewSpecVariantCache(context Context, il []byte) *SpecVariantCache {
+	return &SpecVariantCache{
+		context:  context,
+		il:       il,
+		variants: make(map[[sha256.Size]byte]Program),
+	}
+}
+
+// Build returns a program of the module specialized with the given constants and built for the
+// devices with the given options. A variant already built for the same devices, options, and
+// constants is returned retained instead of being rebuilt; the device order does not matter.
+// The caller owns the returned reference and releases it with ReleaseProgram() as usual.
+//
+// On a build failure, the partially built program is released after the build log became part
+// of the returned error via ProgramBuildLogInfo, and nothing is cached.
+func (cache *SpecVariantCache) Build(devices []DeviceID, options string, constants *SpecConstantSet) (Program, error) {
+	digest := sha256.New()
+	sortedDevices := make([]DeviceID, len(devices))
+	copy(sortedDevices, devices)
+	sort.Slice(sortedDevices, func(i, j int) bool { return sortedDevices[i] < sortedDevices[j] })
+	var scratch [8]byte
+	for _, device := range sortedDevices {
+		binary.LittleEndian.PutUint64(scratch[:], uint64(device))
+		digest.Write(scratch[:])
+	}
+	digest.Write([]byte{0})
+	digest.Write([]byte(options))
+	digest.Write([]byte{0})
+	if constants != nil {
+		constantSum := constants.hash()
+		digest.Write(constantSum[:])
+	}
+	var key [sha256.Size]byte
+	copy(key[:], digest.Sum(nil))
+	cache.mutex.Lock()
+	defer cache.mutex.Unlock()
+	if program, ok := cache.variants[key]; ok {
+		if err := RetainProgram(program); err != nil {
+			return 0, err
+		}
+		return program, nil
+	}
+	program, err := CreateProgramWithIl(cache.context, cache.il)
+	if err != nil {
+		return 0, err
+	}
+	if constants != nil {
+		if _, err := constants.Apply(program); err != nil {
+			_ = ReleaseProgram(program)
+			return 0, err
+		}
+	}
+	if err := BuildProgram(program, devices, options, nil); err != nil {
+		err = specVariantBuildError(program, devices, err)
+		_ = ReleaseProgram(program)
+		return 0, err
+	}
+	if err := RetainProgram(program); err != nil {
+		_ = ReleaseProgram(program)
+		return 0, err
+	}
+	cache.variants[key] = program
+	return program, nil
+}
+
+// Release releases all cached variant programs.
+// The first encountered error is returned, the remaining programs are released regardless.
+func (cache *SpecVariantCache) Release() error {
+	cache.mutex.Lock()
+	defer cache.mutex.Unlock()
+	var firstError error
+	for key, program := range cache.variants {
+		err := ReleaseProgram(program)
+		if (err != nil) && (firstError == nil) {
+			firstError = err
+		}
+		delete(cache.variants, key)
+	}
+	return firstError
+}
+
+// specVariantBuildError wraps a build failure with the logs of the failed devices.
+func specVariantBuildError(program Program, devices []DeviceID, err error) error {
+	failure := BuildFailure{Program: program, Err: err, Logs: buildLogsOf(BuildJob{Program: program, Devices: devices})}
+	return &BuildAllError{Failures: []BuildFailure{failure}}
+}
@@ -0,0 +1,250 @@
+package cl30
+
+// #include "api.h"
+import "C"
+import (
+	"sync"
+	"unsafe"
+)
+
+// StagingBuffer is a block of pinned host memory, suitable as source or destination of
+// high-bandwidth buffer transfers.
+//
+// The block is backed by a buffer object created with MemAllocHostPtrFlag, mapped into the host
+// address space for its entire lifetime. Transfers from or to such memory typically reach the full
+// DMA bandwidth of the device, as the driver does not need to stage the data internally.
+type StagingBuffer struct {
+	mem  MemObject
+	ptr  unsafe.Pointer
+	size int
+}
+
+// Mem returns the buffer object backing the pinned memory block.
+func (buffer *StagingBuffer) Mem() MemObject {
+	return buffer.mem
+}
+
+// Ptr returns the host address of the pinned memory block.
+func (buffer *StagingBuffer) Ptr() unsafe.Pointer {
+	return buffer.ptr
+}
+
+// Size returns the size of the pinned memory block in bytes.
+func (buffer *StagingBuffer) Size() int {
+	return buffer.size
+}
+
+// Bytes returns the pinned memory block as a byte slice.
+func (buffer *StagingBuffer) Bytes() []byte {
+	return unsafe.Slice((*byte)(buffer.ptr), buffer.size)
+}
+
+// StagingPool manages a set of reusable pinned host-memory blocks.
+//
+// Creating and mapping pinned memory is expensive, so transfers should reuse a small set of
+// staging buffers instead of allocating per transfer. Acquire() hands out a free buffer of
+// sufficient size - creating one if necessary - and Release() returns it for reuse.
+//
+// WriteThrough() and ReadThrough() move large host transfers through the pool in pipelined
+// chunks, so callers do not have to compose the chunking and overlap themselves.
+//
+// A StagingPool is safe for concurrent use.
+type StagingPool struct {
+	context      Context
+	commandQueue CommandQueue
+
+	mutex sync.Mutex
+	free  []*StagingBuffer
+}
+
+// NewStagingPool returns a pool that creates pinned buffers in the given context.
+// The command-queue is used for the map and unmap operations of the buffer lifecycle.
+func NewStagingPool(context Context, commandQueue CommandQueue) *StagingPool {
+	return &StagingPool{context: context, commandQueue: commandQueue}
+}
+
+// Acquire returns a pinned staging buffer with at least the given size in bytes.
+// The smallest suitable free buffer is preferred; a new one is created if none fits.
+func (pool *StagingPool) Acquire(size int) (*StagingBuffer, error) {
+	pool.mutex.Lock()
+	bestIndex := -1
+	for i, buffer := range pool.free {
+		if buffer.size < size {
+			continue
+		}
+		if (bestIndex < 0) || (buffer.size < pool.free[bestIndex].size) {
+			bestIndex = i
+		}
+	}
+	if bestIndex >= 0 {
+		buffer := pool.free[bestIndex]
+		lastIndex := len(pool.free) - 1
+		pool.free[bestIndex] = pool.free[lastIndex]
+		pool.free = pool.free[:lastIndex]
+		pool.mutex.Unlock()
+		return buffer, nil
+	}
+	pool.mutex.Unlock()
+	return pool.createBuffer(size)
+}
+
+// Release returns a staging buffer to the pool for reuse.
+// The buffer must no longer be referenced by pending commands.
+func (pool *StagingPool) Release(buffer *StagingBuffer) {
+	pool.mutex.Lock()
+	defer pool.mutex.Unlock()
+	pool.free = append(pool.free, buffer)
+}
+
+// Close destroys all free staging buffers of the pool.
+// Buffers currently acquired are not affected; release them before calling Close().
+// The first encountered error is returned, yet the teardown continues for the remaining buffers.
+func (pool *StagingPool) Close() error {
+	pool.mutex.Lock()
+	buffers := pool.free
+	pool.free = nil
+	pool.mutex.Unlock()
+	var firstErr error
+	for _, buffer := range buffers {
+		err := pool.destroyBuffer(buffer)
+		if (err != nil) && (firstErr == nil) {
+			firstErr = err
+		}
+	}
+	return firstErr
+}
+
+func (pool *StagingPool) createBuffer(size int) (*StagingBuffer, error) {
+	mem, err := CreateBuffer(pool.context, MemAllocHostPtrFlag|MemReadWriteFlag, size, nil)
+	if err != nil {
+		return nil, err
+	}
+	ptr, err := EnqueueMapBuffer(pool.commandQueue, mem, true, MapRead|MapWrite, 0, uintptr(size), nil, nil)
+	if err != nil {
+		_ = ReleaseMemObject(mem)
+		return nil, err
+	}
+	return &StagingBuffer{mem: mem, ptr: ptr, size: size}, nil
+}
+
+func (pool *StagingPool) destroyBuffer(buffer *StagingBuffer) error {
+	err := EnqueueUnmapMemObject(pool.commandQueue, buffer.mem, buffer.ptr, nil, nil)
+	if releaseErr := ReleaseMemObject(buffer.mem); (releaseErr != nil) && (err == nil) {
+		err = releaseErr
+	}
+	return err
+}
+
+const (
+	// stagingChunkBytes is the chunk size of WriteThrough() and ReadThrough() transfers.
+	stagingChunkBytes = 64 * 1024 * 1024
+	// stagingRingDepth is the number of chunks such a transfer keeps in flight.
+	stagingRingDepth = 3
+)
+
+// stagingChunk is one in-flight chunk of a write-through or read-through transfer.
+type stagingChunk struct {
+	staging *StagingBuffer
+	event   Event
+
+	// Copy-out destination for read transfers; nil when writing.
+	dst  unsafe.Pointer
+	size int
+}
+
+// WriteThrough transfers host data into a buffer object, chunked through pinned staging memory.
+//
+// The transfer is split into chunks of at most 64 MiB. While the device transfers one chunk,
+// the host copies the next one into staging memory, so host I/O and device transfer overlap.
+// WriteThrough returns once all chunks have been transferred.
+func (pool *StagingPool) WriteThrough(mem MemObject, offset uintptr, size int, data unsafe.Pointer) error {
+	return pool.transferThrough(mem, offset, size, data, false)
+}
+
+// ReadThrough transfers a range of a buffer object into host memory, chunked through pinned
+// staging memory. The parameters mirror WriteThrough(). ReadThrough returns once all chunks
+// have arrived in the host memory at data.
+func (pool *StagingPool) ReadThrough(mem MemObject, offset uintptr, size int, data unsafe.Pointer) error {
+	return pool.transferThrough(mem, offset, size, data, true)
+}
+
+// transferThrough runs a chunked transfer in the given direction.
+func (pool *StagingPool) transferThrough(mem MemObject, offset uintptr, size int, data unsafe.Pointer, read bool) error {
+	if size == 0 {
+		return nil
+	}
+	if (data == nil) || (size < 0) {
+		return ErrInvalidValue
+	}
+	var ring []stagingChunk
+	for transferred := 0; transferred < size; {
+		chunkSize := size - transferred
+		if chunkSize > stagingChunkBytes {
+			chunkSize = stagingChunkBytes
+		}
+		if len(ring) >= stagingRingDepth {
+			var err error
+			if ring, err = pool.drainOldestChunk(ring); err != nil {
+				pool.drainAllChunks(ring)
+				return err
+			}
+		}
+		staging, err := pool.Acquire(chunkSize)
+		if err != nil {
+			pool.drainAllChunks(ring)
+			return err
+		}
+		chunk := stagingChunk{staging: staging, size: chunkSize}
+		hostBase := unsafe.Add(data, transferred)
+		if read {
+			chunk.dst = hostBase
+			err = EnqueueReadBuffer(pool.commandQueue, mem, false,
+				offset+uintptr(transferred), uintptr(chunkSize), staging.Ptr(), nil, &chunk.event)
+		} else {
+			copy(staging.Bytes()[:chunkSize], unsafe.Slice((*byte)(hostBase), chunkSize))
+			err = EnqueueWriteBuffer(pool.commandQueue, mem, false,
+				offset+uintptr(transferred), uintptr(chunkSize), staging.Ptr(), nil, &chunk.event)
+		}
+		if err != nil {
+			pool.Release(staging)
+			pool.drainAllChunks(ring)
+			return err
+		}
+		ring = append(ring, chunk)
+		if err = Flush(pool.commandQueue); err != nil {
+			pool.drainAllChunks(ring)
+			return err
+		}
+		transferred += chunkSize
+	}
+	var firstError error
+	for len(ring) > 0 {
+		var err error
+		ring, err = pool.drainOldestChunk(ring)
+		if (err != nil) && (firstError == nil) {
+			firstError = err
+		}
+	}
+	return firstError
+}
+
+// drainOldestChunk waits for the oldest in-flight chunk, copying it out for read transfers, and
+// returns its staging buffer to the pool.
+func (pool *StagingPool) drainOldestChunk(ring []stagingChunk) ([]stagingChunk, error) {
+	chunk := ring[0]
+	ring = ring[:copy(ring, ring[1:])]
+	err := AwaitEvents([]Event{chunk.event})
+	_ = ReleaseEvent(chunk.event)
+	if (err == nil) && (chunk.dst != nil) {
+		copy(unsafe.Slice((*byte)(chunk.dst), chunk.size), chunk.staging.Bytes()[:chunk.size])
+	}
+	pool.Release(chunk.staging)
+	return ring, err
+}
+
+// drainAllChunks drains all in-flight chunks, ignoring their results; used on the error path.
+func (pool *StagingPool) drainAllChunks(ring []stagingChunk) {
+	for len(ring) > 0 {
+		ring, _ = pool.drainOldestChunk(ring)
+	}
+}
@@ -1,11 +1,69 @@
 package cl30
 
-// #include "api.h"
+// #include "query_info.h"
 import "C"
 import (
+	"sync"
 	"unsafe"
 )
 
+// stringQuerySizeLimit is the maximum accepted size, in bytes, of a queried string value.
+// It serves as a sanity guard against implementations reporting bogus sizes.
+const stringQuerySizeLimit = 1024 * 1024 * 10
+
+// Query targets understood by cl30QueryInfoString(); they mirror the CL30_QUERY_TARGET_* values in query_info.h.
+const (
+	queryTargetPlatform     = 0
+	queryTargetDevice       = 1
+	queryTargetKernel       = 2
+	queryTargetProgram      = 3
+	queryTargetProgramBuild = 4
+)
+
+// queryScratch recycles the transfer buffers of queryStringShim() between queries.
+var queryScratch = sync.Pool{
+	New: func() any {
+		buffer := make([]byte, 1024)
+		return &buffer
+	},
+}
+
+// queryStringShim extracts a string through the cl30QueryInfoString() helper, which performs the size probe
+// and the value fetch in a single cgo crossing. The transfer buffer is pooled, so repeated queries allocate
+// nothing beyond the returned string itself. Should a value exceed the pooled buffer, the buffer is grown and
+// the query retried.
+func queryStringShim(target uint32, object unsafe.Pointer, secondary unsafe.Pointer, paramName uint32) (string, error) {
+	scratch := queryScratch.Get().(*[]byte)
+	defer queryScratch.Put(scratch)
+	for {
+		buffer := *scratch
+		requiredSize := C.size_t(0)
+		status := C.cl30QueryInfoString(
+			C.cl_uint(target),
+			object,
+			secondary,
+			C.cl_uint(paramName),
+			C.size_t(len(buffer)),
+			unsafe.Pointer(&buffer[0]),
+			&requiredSize)
+		if status != C.CL_SUCCESS {
+			return "", StatusError(status)
+		}
+		if uintptr(requiredSize) > stringQuerySizeLimit {
+			return "", ErrDataSizeLimitExceeded
+		}
+		if requiredSize == 0 {
+			return "", nil
+		}
+		if uintptr(requiredSize) <= uintptr(len(buffer)) {
+			// The reported size includes the terminating 0x00 byte; skip it.
+			return string(buffer[:requiredSize-1]), nil
+		}
+		grown := make([]byte, requiredSize)
+		*scratch = grown
+	}
+}
+
 // queryString extracts a string with the help of a load function.
 // The load function shall return the required number of bytes for the string, including the terminating NUL byte.
 // The load function is called twice, once with zero/nil to query the needed size, then a second time to retrieve
@@ -15,7 +73,7 @@ func queryString(load func(paramSize uintptr, paramValue unsafe.Pointer) (uintpt
 	if err != nil {
 		return "", err
 	}
-	if requiredSize > 1024*1024*10 {
+	if requiredSize > stringQuerySizeLimit {
 		return "", ErrDataSizeLimitExceeded
 	}
 	if requiredSize == 0 {
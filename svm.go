@@ -83,6 +83,7 @@ func EnqueueSvmFree(commandQueue CommandQueue, ptrs []unsafe.Pointer, callback f
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
@@ -117,6 +118,7 @@ func EnqueueSvmMemcpy(commandQueue CommandQueue, blocking bool, dstPtr unsafe.Po
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
@@ -144,6 +146,7 @@ func EnqueueSvmMemFill(commandQueue CommandQueue, svmPtr, pattern unsafe.Pointer
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
@@ -169,6 +172,7 @@ func EnqueueSvmMap(commandQueue CommandQueue, blocking bool, flags MemFlags, svm
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
@@ -191,6 +195,7 @@ func EnqueueSvmUnmap(commandQueue CommandQueue, svmPtr unsafe.Pointer, waitList
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
 
@@ -225,5 +230,6 @@ func EnqueueSvmMigrateMem(commandQueue CommandQueue, svmPtrs []unsafe.Pointer, s
 	if status != C.CL_SUCCESS {
 		return StatusError(status)
 	}
+	trackEventOut(event)
 	return nil
 }
@@ -0,0 +1,123 @@
+package cl30
+
+import (
+	"sync"
+	"unsafe"
+)
+
+const (
+	// svmPoolMinClassSize is the size, in bytes, of the smallest size class of an SvmPool.
+	svmPoolMinClassSize = 256
+	// svmPoolMaxClassSize is the size, in bytes, of the largest size class of an SvmPool.
+	// Larger requests bypass the pool and are served by SvmAlloc() directly.
+	svmPoolMaxClassSize = 4 * 1024 * 1024
+)
+
+// SvmPool is a caching allocator over shared virtual memory with power-of-two size classes.
+//
+// SvmAlloc() is a driver round trip and typically holds a context-wide driver lock, making it
+// expensive for frequent small allocations. The pool rounds requested sizes up to power-of-two
+// size classes and keeps freed blocks per class for reuse, so steady-state allocation of
+// recurring sizes is served from the host-side free lists without driver involvement. Cold
+// allocations, and requests larger than the biggest size class, still pay the SvmAlloc() cost.
+//
+// The pool deliberately recycles whole driver allocations instead of carving blocks out of
+// larger slabs: coarse-grain SVM migrates at allocation granularity, so blocks sub-allocated
+// from a shared slab would drag their unrelated neighbors along on every first touch, and
+// SvmFree() - including the enqueued variant - only accepts allocation base pointers, which
+// slab-interior blocks are not.
+//
+// An SvmPool is safe for concurrent use.
+type SvmPool struct {
+	context   Context
+	flags     SvmMemFlags
+	alignment uint32
+
+	mutex       sync.Mutex
+	free        map[int][]uintptr
+	outstanding map[uintptr]int
+}
+
+// NewSvmPool returns a pool that serves allocations from the given context.
+// The flags and alignment are applied to every underlying SvmAlloc() call; see SvmAlloc() for
+// their meaning.
+func NewSvmPool(context Context, flags SvmMemFlags, alignment uint32) *SvmPool {
+	return &SvmPool{
+		context:     context,
+		flags:       flags,
+		alignment:   alignment,
+		free:        map[int][]uintptr{},
+		outstanding: map[uintptr]int{},
+	}
+}
+
+// Alloc returns a shared virtual memory block with at least the given size in bytes.
+// The block is either reused from the free list of the matching size class, or newly allocated.
+func (pool *SvmPool) Alloc(size int) (unsafe.Pointer, error) {
+	class, classSize := svmPoolClassFor(size)
+	if class >= 0 {
+		pool.mutex.Lock()
+		if freeList := pool.free[class]; len(freeList) > 0 {
+			ptr := freeList[len(freeList)-1]
+			pool.free[class] = freeList[:len(freeList)-1]
+			pool.outstanding[ptr] = class
+			pool.mutex.Unlock()
+			return unsafe.Pointer(ptr), nil
+		}
+		pool.mutex.Unlock()
+		size = classSize
+	}
+	ptr, err := SvmAlloc(pool.context, pool.flags, size, pool.alignment)
+	if err != nil {
+		return nil, err
+	}
+	pool.mutex.Lock()
+	pool.outstanding[uintptr(ptr)] = class
+	pool.mutex.Unlock()
+	return ptr, nil
+}
+
+// Free returns a block previously obtained from Alloc() to the pool.
+// Blocks of pooled size classes go back to their free list; oversized blocks are freed directly.
+// As with SvmFree(), the caller must ensure that enqueued commands using the block have finished.
+func (pool *SvmPool) Free(ptr unsafe.Pointer) {
+	pool.mutex.Lock()
+	class, known := pool.outstanding[uintptr(ptr)]
+	delete(pool.outstanding, uintptr(ptr))
+	if known && (class >= 0) {
+		pool.free[class] = append(pool.free[class], uintptr(ptr))
+		pool.mutex.Unlock()
+		return
+	}
+	pool.mutex.Unlock()
+	SvmFree(pool.context, ptr)
+}
+
+// Release frees all pooled blocks that are currently on the free lists.
+// Outstanding blocks are not affected; free them before calling Release().
+func (pool *SvmPool) Release() {
+	pool.mutex.Lock()
+	freeLists := pool.free
+	pool.free = map[int][]uintptr{}
+	pool.mutex.Unlock()
+	for _, freeList := range freeLists {
+		for _, ptr := range freeList {
+			SvmFree(pool.context, unsafe.Pointer(ptr))
+		}
+	}
+}
+
+// svmPoolClassFor determines the size class for a request. It returns a class index of -1 for
+// requests that bypass the pooling, together with the effective allocation size.
+func svmPoolClassFor(size int) (int, int) {
+	if size > svmPoolMaxClassSize {
+		return -1, size
+	}
+	class := 0
+	classSize := svmPoolMinClassSize
+	for classSize < size {
+		classSize *= 2
+		class++
+	}
+	return class, classSize
+}
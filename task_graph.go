@@ -0,0 +1,195 @@
+package cl30
+
+// TaskID identifies one node of a TaskGraph.
+type TaskID int
+
+// TaskFunc enqueues the command of one task. The provided wait list covers all dependencies of
+// the task and must be passed on to the Enqueue* call; the resulting event must be stored in
+// event. The wait list slice is only valid for the duration of the call.
+type TaskFunc func(commandQueue CommandQueue, waitList []Event, event *Event) error
+
+// taskNode is one node of a TaskGraph.
+type taskNode struct {
+	run   TaskFunc
+	deps  []TaskID
+	event Event
+}
+
+// TaskGraph submits a dependency graph of commands with minimal wait lists.
+//
+// Composing a command graph by hand means threading []Event wait lists into every enqueue call,
+// which is error-prone and re-marshals each slice per call. With a TaskGraph, tasks declare their
+// dependencies once via AddTask(). On submission, the graph drops every dependency that is
+// already implied transitively by another one, reuses a single preallocated event array for all
+// wait lists, and enqueues the tasks in topological order.
+//
+// A graph is built once and can be submitted many times, for example once per iteration of a
+// computation; the pruned dependency lists are computed on first submission and reused.
+// A TaskGraph is not safe for concurrent use.
+type TaskGraph struct {
+	nodes []taskNode
+
+	pruned      [][]TaskID
+	waitScratch []Event
+}
+
+// NewTaskGraph creates an empty task graph.
+func NewTaskGraph() *TaskGraph {
+	return &TaskGraph{}
+}
+
+// AddTask adds a task that depends on the completion of the given earlier tasks.
+//
+// Dependencies must have been added before the task that depends on them; this keeps the graph
+// acyclic by construction, and the insertion order is a valid topological order.
+// ErrInvalidValue is returned if run is nil or a dependency is unknown.
+func (graph *TaskGraph) AddTask(run TaskFunc, deps ...TaskID) (TaskID, error) {
+	id := TaskID(len(graph.nodes))
+	if run == nil {
+		return 0, ErrInvalidValue
+	}
+	for _, dep := range deps {
+		if (dep < 0) || (dep >= id) {
+			return 0, ErrInvalidValue
+		}
+	}
+	node := taskNode{run: run}
+	if len(deps) > 0 {
+		node.deps = append([]TaskID{}, deps...)
+	}
+	graph.nodes = append(graph.nodes, node)
+	graph.pruned = nil
+	return id, nil
+}
+
+// TaskCount returns the number of tasks in the graph.
+func (graph *TaskGraph) TaskCount() int {
+	return len(graph.nodes)
+}
+
+// Submit enqueues all tasks of the graph on the given command-queue, in topological order and
+// with minimal wait lists. The queue should be created with QueueOutOfOrderExecModeEnable;
+// on an in-order queue, use SubmitInOrder() instead, which skips the wait lists entirely.
+//
+// The returned event completes once all tasks of the graph have completed; the caller owns it.
+// All intermediate events are released before Submit returns. On error, commands enqueued so far
+// remain on the queue, their events are released, and no completion event is returned.
+func (graph *TaskGraph) Submit(commandQueue CommandQueue) (Event, error) {
+	pruned := graph.prunedDeps()
+	for i := range graph.nodes {
+		node := &graph.nodes[i]
+		waitList := graph.waitScratch[:0]
+		for _, dep := range pruned[i] {
+			waitList = append(waitList, graph.nodes[dep].event)
+		}
+		graph.waitScratch = waitList
+		node.event = 0
+		if err := node.run(commandQueue, waitList, &node.event); err != nil {
+			graph.releaseEvents(i)
+			return 0, err
+		}
+	}
+	leaves := graph.waitScratch[:0]
+	for i, node := range graph.nodes {
+		if graph.isLeaf(pruned, TaskID(i)) {
+			leaves = append(leaves, node.event)
+		}
+	}
+	graph.waitScratch = leaves
+	var completion Event
+	err := EnqueueMarkerWithWaitList(commandQueue, leaves, &completion)
+	graph.releaseEvents(len(graph.nodes))
+	if err != nil {
+		return 0, err
+	}
+	return completion, nil
+}
+
+// SubmitInOrder enqueues all tasks of the graph on an in-order command-queue.
+//
+// In-order queues execute commands in submission order, so the topological insertion order
+// alone already satisfies every dependency and all wait lists stay empty.
+// The returned event completes once all tasks have completed; the caller owns it.
+func (graph *TaskGraph) SubmitInOrder(commandQueue CommandQueue) (Event, error) {
+	for i := range graph.nodes {
+		node := &graph.nodes[i]
+		node.event = 0
+		if err := node.run(commandQueue, nil, &node.event); err != nil {
+			graph.releaseEvents(i)
+			return 0, err
+		}
+	}
+	var completion Event
+	err := EnqueueMarkerWithWaitList(commandQueue, nil, &completion)
+	graph.releaseEvents(len(graph.nodes))
+	if err != nil {
+		return 0, err
+	}
+	return completion, nil
+}
+
+// prunedDeps returns the dependency lists with transitively implied edges removed.
+// The result is cached until the graph changes.
+func (graph *TaskGraph) prunedDeps() [][]TaskID {
+	if graph.pruned != nil {
+		return graph.pruned
+	}
+	wordCount := (len(graph.nodes) + 63) / 64
+	reachable := make([][]uint64, len(graph.nodes))
+	bits := make([]uint64, len(graph.nodes)*wordCount)
+	pruned := make([][]TaskID, len(graph.nodes))
+	for i, node := range graph.nodes {
+		reach := bits[i*wordCount : (i+1)*wordCount]
+		reachable[i] = reach
+		for _, dep := range node.deps {
+			reach[dep/64] |= uint64(1) << (uint64(dep) % 64)
+			for w, word := range reachable[dep] {
+				reach[w] |= word
+			}
+		}
+		kept := make([]TaskID, 0, len(node.deps))
+		for _, dep := range node.deps {
+			if !graph.impliedByOther(reachable, node.deps, dep) {
+				kept = append(kept, dep)
+			}
+		}
+		pruned[i] = kept
+	}
+	graph.pruned = pruned
+	return pruned
+}
+
+// impliedByOther reports whether dep is reachable through any other entry of deps.
+func (graph *TaskGraph) impliedByOther(reachable [][]uint64, deps []TaskID, dep TaskID) bool {
+	for _, other := range deps {
+		if other == dep {
+			continue
+		}
+		if (reachable[other][dep/64] & (uint64(1) << (uint64(dep) % 64))) != 0 {
+			return true
+		}
+	}
+	return false
+}
+
+// isLeaf reports whether no other task depends on the given one.
+func (graph *TaskGraph) isLeaf(pruned [][]TaskID, id TaskID) bool {
+	for i := int(id) + 1; i < len(pruned); i++ {
+		for _, dep := range pruned[i] {
+			if dep == id {
+				return false
+			}
+		}
+	}
+	return true
+}
+
+// releaseEvents releases the events of the first count tasks.
+func (graph *TaskGraph) releaseEvents(count int) {
+	for i := 0; i < count; i++ {
+		if graph.nodes[i].event != 0 {
+			_ = ReleaseEvent(graph.nodes[i].event)
+		}
+		graph.nodes[i].event = 0
+	}
+}
@@ -0,0 +1,252 @@
+package cl30
+
+import (
+	"encoding/json"
+	"io"
+	"sync"
+	"time"
+)
+
+// timelineSample is one simultaneous reading of a device timer and the host timer.
+type timelineSample struct {
+	device uint64
+	host   uint64
+}
+
+// timelineClockWindow is the number of samples the drift fit looks back on.
+const timelineClockWindow = 32
+
+// timelineDeviceClock models the host timeline of one device timer as offset plus drift.
+type timelineDeviceClock struct {
+	id        DeviceID
+	samples   []timelineSample
+	slope     float64
+	offset    float64
+	intercept timelineSample
+}
+
+// TimelineClock correlates device timestamps from multiple devices onto one host timeline.
+//
+// Device timers run on their own crystals: a single offset taken at startup drifts away by
+// microseconds per second, which makes cross-device comparisons of EventProfilingInfo
+// timestamps meaningless. The clock samples DeviceAndHostTimer() for every device on a fixed
+// cadence, fits offset and drift over a sliding window with a least-squares regression, and
+// HostTime() converts device timestamps to host nanoseconds using that fit.
+//
+// WriteTrace() emits correlated spans in the Chrome trace event format, viewable in
+// chrome://tracing or Perfetto, with one track per device.
+//
+// A TimelineClock is safe for concurrent use.
+type TimelineClock struct {
+	mutex   sync.Mutex
+	devices []*timelineDeviceClock
+
+	stop chan struct{}
+	done chan struct{}
+}
+
+// NewTimelineClock creates a clock correlating the timers of the given devices.
+//
+// Every device is sampled once immediately; afterwards a background goroutine resamples all
+// devices on the given interval and refreshes the drift fits. An interval of zero or below
+// disables background sampling, leaving the cadence to explicit Resample() calls.
+func NewTimelineClock(devices []DeviceID, interval time.Duration) (*TimelineClock, error) {
+	clock := &TimelineClock{
+		stop: make(chan struct{}),
+		done: make(chan struct{}),
+	}
+	for _, id := range devices {
+		clock.devices = append(clock.devices, &timelineDeviceClock{id: id, slope: 1.0})
+	}
+	if err := clock.Resample(); err != nil {
+		return nil, err
+	}
+	if interval > 0 {
+		go clock.run(interval)
+	} else {
+		close(clock.done)
+	}
+	return clock, nil
+}
+
+// Close stops the background sampling.
+func (clock *TimelineClock) Close() {
+	select {
+	case <-clock.stop:
+	default:
+		close(clock.stop)
+	}
+	<-clock.done
+}
+
+// Resample takes one DeviceAndHostTimer() reading per device and refreshes the drift fits.
+func (clock *TimelineClock) Resample() error {
+	clock.mutex.Lock()
+	defer clock.mutex.Unlock()
+	var firstError error
+	for _, device := range clock.devices {
+		deviceTime, hostTime, err := DeviceAndHostTimer(device.id)
+		if err != nil {
+			if firstError == nil {
+				firstError = err
+			}
+			continue
+		}
+		device.samples = append(device.samples, timelineSample{device: deviceTime, host: hostTime})
+		if len(device.samples) > timelineClockWindow {
+			device.samples = device.samples[:copy(device.samples, device.samples[1:])]
+		}
+		device.refit()
+	}
+	return firstError
+}
+
+// HostTime converts a device timestamp, as reported by EventProfilingInfo() for the given
+// device, to host nanoseconds. ErrInvalidDevice is returned for devices unknown to the clock.
+func (clock *TimelineClock) HostTime(id DeviceID, deviceTimestamp uint64) (uint64, error) {
+	clock.mutex.Lock()
+	defer clock.mutex.Unlock()
+	device := clock.deviceClock(id)
+	if device == nil {
+		return 0, ErrInvalidDevice
+	}
+	return device.hostTime(deviceTimestamp), nil
+}
+
+// TimelineSpan is one correlated span of work for trace emission.
+type TimelineSpan struct {
+	// Name labels the span in the trace viewer.
+	Name string
+	// Device selects the track of the span and the timer its timestamps belong to.
+	Device DeviceID
+	// Start and End are device timestamps in nanoseconds, as reported by EventProfilingInfo().
+	Start uint64
+	End   uint64
+}
+
+// SpanOf builds a span from a collected profiling sample of the given device.
+func SpanOf(device DeviceID, sample ProfilingSample) TimelineSpan {
+	return TimelineSpan{Name: sample.Label, Device: device, Start: sample.Start, End: sample.End}
+}
+
+// chromeTraceEvent is one entry of the Chrome trace event format.
+type chromeTraceEvent struct {
+	Name      string  `json:"name"`
+	Phase     string  `json:"ph"`
+	Timestamp float64 `json:"ts"`
+	Duration  float64 `json:"dur"`
+	ProcessID int     `json:"pid"`
+	ThreadID  int     `json:"tid"`
+}
+
+// chromeTrace is the top-level object of the Chrome trace event format.
+type chromeTrace struct {
+	TraceEvents     []chromeTraceEvent `json:"traceEvents"`
+	DisplayTimeUnit string             `json:"displayTimeUnit"`
+}
+
+// WriteTrace converts the spans onto the host timeline and writes them in the Chrome trace
+// event format. Each device becomes one track (thread) of the trace; spans of devices unknown
+// to the clock are skipped. Timestamps are emitted in microseconds, as the format requires.
+func (clock *TimelineClock) WriteTrace(writer io.Writer, spans []TimelineSpan) error {
+	clock.mutex.Lock()
+	trace := chromeTrace{TraceEvents: make([]chromeTraceEvent, 0, len(spans)), DisplayTimeUnit: "ns"}
+	for _, span := range spans {
+		device := clock.deviceClock(span.Device)
+		if (device == nil) || (span.End < span.Start) {
+			continue
+		}
+		start := device.hostTime(span.Start)
+		end := device.hostTime(span.End)
+		track := clock.deviceIndex(span.Device)
+		trace.TraceEvents = append(trace.TraceEvents, chromeTraceEvent{
+			Name:      span.Name,
+			Phase:     "X",
+			Timestamp: float64(start) / 1000.0,
+			Duration:  float64(end-start) / 1000.0,
+			ProcessID: 1,
+			ThreadID:  track,
+		})
+	}
+	clock.mutex.Unlock()
+	return json.NewEncoder(writer).Encode(&trace)
+}
+
+// run resamples all devices on the given cadence until Close() is called.
+func (clock *TimelineClock) run(interval time.Duration) {
+	defer close(clock.done)
+	ticker := time.NewTicker(interval)
+	defer ticker.Stop()
+	for {
+		select {
+		case <-clock.stop:
+			return
+		case <-ticker.C:
+			_ = clock.Resample()
+		}
+	}
+}
+
+// deviceClock returns the per-device clock, or nil for unknown devices.
+// The caller must hold the clock mutex.
+func (clock *TimelineClock) deviceClock(id DeviceID) *timelineDeviceClock {
+	for _, device := range clock.devices {
+		if device.id == id {
+			return device
+		}
+	}
+	return nil
+}
+
+// deviceIndex returns the position of the device, used as its trace track.
+func (clock *TimelineClock) deviceIndex(id DeviceID) int {
+	for i, device := range clock.devices {
+		if device.id == id {
+			return i
+		}
+	}
+	return -1
+}
+
+// refit recomputes slope and intercept with a least-squares fit over the sample window.
+// The newest sample anchors the fit, so conversions near the present are the most accurate.
+func (device *timelineDeviceClock) refit() {
+	count := len(device.samples)
+	if count == 0 {
+		return
+	}
+	device.intercept = device.samples[count-1]
+	if count == 1 {
+		device.slope = 1.0
+		device.offset = 0
+		return
+	}
+	// Center the samples on the anchor to keep the float64 arithmetic precise despite
+	// nanosecond counters in the 1e18 range.
+	var meanDevice, meanHost float64
+	for _, sample := range device.samples {
+		meanDevice += float64(int64(sample.device - device.intercept.device))
+		meanHost += float64(int64(sample.host - device.intercept.host))
+	}
+	meanDevice /= float64(count)
+	meanHost /= float64(count)
+	var covariance, variance float64
+	for _, sample := range device.samples {
+		deltaDevice := float64(int64(sample.device-device.intercept.device)) - meanDevice
+		deltaHost := float64(int64(sample.host-device.intercept.host)) - meanHost
+		covariance += deltaDevice * deltaHost
+		variance += deltaDevice * deltaDevice
+	}
+	if variance == 0 {
+		device.slope = 1.0
+	} else {
+		device.slope = covariance / variance
+	}
+	device.offset = meanHost - device.slope*meanDevice
+}
+
+// hostTime converts one device timestamp with the current fit.
+func (device *timelineDeviceClock) hostTime(deviceTimestamp uint64) uint64 {
+	delta := float64(int64(deviceTimestamp - device.intercept.device))
+	return uint64(int64(device.intercept.host) + int64(device.offset+device.slope*delta))
+}